@@ -0,0 +1,455 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "../s21_band_matrix.h"
+#include "../s21_krylov.h"
+#include "../s21_lu.h"
+#include "../s21_matrix_chain.h"
+#include "../s21_matrix_graph.h"
+#include "../s21_matrix_oop.h"
+#include "../s21_numa.h"
+#include "../s21_quantized_matrix.h"
+#include "../s21_svd.h"
+#include "../s21_symmetric_matrix.h"
+#include "../s21_triangular_matrix.h"
+
+namespace s21 {
+
+S21Matrix MakeMatrix(const int rows, const int cols) {
+  S21Matrix result(rows, cols);
+  for (int i = 1; i <= rows; ++i) {
+    for (int j = 1; j <= cols; ++j) {
+      result(i, j) = ((i * 7 + j * 13) % 17) - 8 + (i == j ? rows * 4 : 0);
+    }
+  }
+  return result;
+}
+
+void BM_MulMatrix(benchmark::State &state) {
+  const int size = state.range(0);
+  S21Matrix lhs = MakeMatrix(size, size);
+  S21Matrix rhs = MakeMatrix(size, size);
+  for (auto _ : state) {
+    S21Matrix result = lhs * rhs;
+    benchmark::DoNotOptimize(result);
+  }
+  state.counters["flops"] = benchmark::Counter(
+      2.0 * size * size * size, benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_MulMatrix)->RangeMultiplier(2)->Range(8, 512);
+
+void BM_MulVector(benchmark::State &state) {
+  const int size = state.range(0);
+  S21Matrix matrix = MakeMatrix(size, size);
+  S21Matrix x = MakeMatrix(size, 1);
+  S21Matrix y(size, 1);
+  for (auto _ : state) {
+    if (state.range(1) == 2) {
+      y = matrix * x;
+    } else {
+      matrix.MulVector(x, y, state.range(1));
+    }
+    benchmark::DoNotOptimize(y);
+  }
+  state.counters["flops"] = benchmark::Counter(
+      2.0 * size * size, benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_MulVector)->ArgsProduct({{64, 512, 2048}, {0, 1, 2}});
+
+void BM_Determinant(benchmark::State &state) {
+  S21Matrix matrix = MakeMatrix(state.range(0), state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(matrix.Determinant());
+  }
+}
+BENCHMARK(BM_Determinant)->DenseRange(2, 9)->Arg(64)->Arg(256);
+
+void BM_InverseMatrix(benchmark::State &state) {
+  S21Matrix matrix = MakeMatrix(state.range(0), state.range(0));
+  for (auto _ : state) {
+    S21Matrix result = matrix.InverseMatrix();
+    benchmark::DoNotOptimize(result);
+  }
+}
+BENCHMARK(BM_InverseMatrix)->DenseRange(2, 7)->Arg(64)->Arg(256);
+
+void BM_LU(benchmark::State &state) {
+  const int size = state.range(0);
+  S21Matrix matrix = MakeMatrix(size, size);
+  for (auto _ : state) {
+    S21LU lu(matrix, state.range(1));
+    benchmark::DoNotOptimize(lu.Determinant());
+  }
+  state.counters["flops"] =
+      benchmark::Counter(2.0 / 3.0 * size * size * size,
+                         benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_LU)->ArgsProduct({{128, 512, 1024}, {16, 64, 128}});
+
+void BM_Transpose(benchmark::State &state) {
+  S21Matrix matrix = MakeMatrix(state.range(0), state.range(0));
+  for (auto _ : state) {
+    S21Matrix result = matrix.Transpose();
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetBytesProcessed(state.iterations() * 2 * sizeof(double) *
+                          state.range(0) * state.range(0));
+}
+BENCHMARK(BM_Transpose)->RangeMultiplier(4)->Range(8, 2048);
+
+void BM_SumMatrix(benchmark::State &state) {
+  S21Matrix lhs = MakeMatrix(state.range(0), state.range(0));
+  S21Matrix rhs = MakeMatrix(state.range(0), state.range(0));
+  for (auto _ : state) {
+    lhs.SumMatrix(rhs);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * 3 * sizeof(double) *
+                          state.range(0) * state.range(0));
+}
+BENCHMARK(BM_SumMatrix)->RangeMultiplier(4)->Range(8, 2048);
+
+void BM_SubMatrix(benchmark::State &state) {
+  S21Matrix lhs = MakeMatrix(state.range(0), state.range(0));
+  S21Matrix rhs = MakeMatrix(state.range(0), state.range(0));
+  for (auto _ : state) {
+    lhs.SubMatrix(rhs);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * 3 * sizeof(double) *
+                          state.range(0) * state.range(0));
+}
+BENCHMARK(BM_SubMatrix)->RangeMultiplier(4)->Range(8, 2048);
+
+void BM_MulNumber(benchmark::State &state) {
+  S21Matrix matrix = MakeMatrix(state.range(0), state.range(0));
+  for (auto _ : state) {
+    matrix.MulNumber(1.0000001);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * 2 * sizeof(double) *
+                          state.range(0) * state.range(0));
+}
+BENCHMARK(BM_MulNumber)->RangeMultiplier(4)->Range(8, 2048);
+
+void BM_EqMatrix(benchmark::State &state) {
+  S21Matrix lhs = MakeMatrix(state.range(0), state.range(0));
+  S21Matrix rhs = MakeMatrix(state.range(0), state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs.EqMatrix(rhs));
+  }
+}
+BENCHMARK(BM_EqMatrix)->RangeMultiplier(4)->Range(8, 2048);
+
+void BM_ApproxEqual(benchmark::State &state) {
+  S21Matrix lhs = MakeMatrix(state.range(0), state.range(0));
+  S21Matrix rhs = MakeMatrix(state.range(0), state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs.ApproxEqual(rhs, 1e-9, 1e-9));
+  }
+  state.SetBytesProcessed(state.iterations() * 2 * sizeof(double) *
+                          state.range(0) * state.range(0));
+}
+BENCHMARK(BM_ApproxEqual)->RangeMultiplier(4)->Range(8, 2048);
+
+void BM_Reduction(benchmark::State &state) {
+  S21Matrix matrix = MakeMatrix(state.range(0), state.range(0));
+  for (auto _ : state) {
+    switch (state.range(1)) {
+      case 0:
+        benchmark::DoNotOptimize(matrix.Sum());
+        break;
+      case 1:
+        benchmark::DoNotOptimize(matrix.NormFrobenius());
+        break;
+      case 2:
+        benchmark::DoNotOptimize(matrix.Norm1());
+        break;
+      default:
+        benchmark::DoNotOptimize(matrix.Max());
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * sizeof(double) *
+                          state.range(0) * state.range(0));
+}
+BENCHMARK(BM_Reduction)->ArgsProduct({{64, 512, 2048}, {0, 1, 2, 3}});
+
+void BM_Copy(benchmark::State &state) {
+  S21Matrix matrix = MakeMatrix(state.range(0), state.range(0));
+  matrix.set_copy_on_write(state.range(1));
+  for (auto _ : state) {
+    S21Matrix copy{matrix};
+    benchmark::DoNotOptimize(copy);
+  }
+}
+BENCHMARK(BM_Copy)->ArgsProduct({{8, 64, 512, 2048}, {0, 1}});
+
+void BM_Move(benchmark::State &state) {
+  S21Matrix matrix = MakeMatrix(state.range(0), state.range(0));
+  for (auto _ : state) {
+    S21Matrix moved{std::move(matrix)};
+    matrix = std::move(moved);
+    benchmark::DoNotOptimize(matrix);
+  }
+}
+BENCHMARK(BM_Move)->RangeMultiplier(8)->Range(8, 2048);
+
+void BM_ElementAccess(benchmark::State &state) {
+  S21Matrix matrix = MakeMatrix(state.range(0), state.range(0));
+  const bool checked = state.range(1);
+  for (auto _ : state) {
+    double sum = 0.0;
+    if (checked) {
+      for (int i = 1; i <= matrix.get_rows(); ++i) {
+        for (int j = 1; j <= matrix.get_cols(); ++j) {
+          sum += matrix(i, j);
+        }
+      }
+    } else {
+      for (double value : static_cast<const S21Matrix &>(matrix)) {
+        sum += value;
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+}
+BENCHMARK(BM_ElementAccess)->ArgsProduct({{64, 512}, {0, 1}});
+
+void BM_Power(benchmark::State &state) {
+  S21Matrix matrix = MakeMatrix(64, 64);
+  matrix.MulNumber(1.0 / 1024);
+  for (auto _ : state) {
+    S21Matrix result = matrix.Power(state.range(0));
+    benchmark::DoNotOptimize(result);
+  }
+}
+BENCHMARK(BM_Power)->RangeMultiplier(4)->Range(4, 1024);
+
+// Arg 0 multiplies left to right, arg 1 uses the planned order.
+void BM_MatrixChain(benchmark::State &state) {
+  const int size = 256;
+  S21Matrix tall = MakeMatrix(size, 8);
+  S21Matrix wide = MakeMatrix(8, size);
+  S21MatrixChain chain{tall, wide, tall, wide};
+  for (auto _ : state) {
+    S21Matrix result =
+        state.range(0) ? chain.Evaluate() : tall * wide * tall * wide;
+    benchmark::DoNotOptimize(result);
+  }
+}
+BENCHMARK(BM_MatrixChain)->Arg(0)->Arg(1);
+
+void BM_TriangularSolve(benchmark::State &state) {
+  const int size = state.range(0);
+  S21Matrix source = MakeMatrix(size, size);
+  for (int i = 0; i < size; ++i) {
+    source[i][i] += size * size;
+  }
+  S21TriangularMatrix matrix(source);
+  S21Matrix rhs = MakeMatrix(size, state.range(1));
+  for (auto _ : state) {
+    S21Matrix result = matrix.Solve(rhs);
+    benchmark::DoNotOptimize(result);
+  }
+}
+BENCHMARK(BM_TriangularSolve)->ArgsProduct({{128, 512}, {1, 64}});
+
+// Arg 1 selects 0 for Transpose() * A and 1 for the packed Gram kernel.
+void BM_Gram(benchmark::State &state) {
+  S21Matrix matrix = MakeMatrix(2 * state.range(0), state.range(0));
+  for (auto _ : state) {
+    if (state.range(1)) {
+      S21SymmetricMatrix result = S21SymmetricMatrix::Gram(matrix);
+      benchmark::DoNotOptimize(result);
+    } else {
+      S21Matrix result = matrix.Transpose() * matrix;
+      benchmark::DoNotOptimize(result);
+    }
+  }
+}
+BENCHMARK(BM_Gram)->ArgsProduct({{64, 256}, {0, 1}});
+
+void BM_SVD(benchmark::State &state) {
+  S21Matrix matrix = MakeMatrix(2 * state.range(0), state.range(0));
+  for (auto _ : state) {
+    S21SVD svd(matrix);
+    benchmark::DoNotOptimize(svd);
+  }
+}
+BENCHMARK(BM_SVD)->RangeMultiplier(4)->Range(16, 256);
+
+void BM_RandomizedSVD(benchmark::State &state) {
+  S21Matrix matrix = MakeMatrix(state.range(0), state.range(0) / 8);
+  for (auto _ : state) {
+    S21SVD svd = S21SVD::Randomized(matrix, state.range(1));
+    benchmark::DoNotOptimize(svd);
+  }
+}
+BENCHMARK(BM_RandomizedSVD)->ArgsProduct({{4096, 16384}, {10, 50}});
+
+void BM_BandSolve(benchmark::State &state) {
+  const int size = state.range(0);
+  const int width = state.range(1);
+  S21BandMatrix band(size, width, width);
+  for (int i = 1; i <= size; ++i) {
+    for (int j = std::max(1, i - width); j <= std::min(size, i + width); ++j) {
+      band(i, j) = i == j ? 4.0 * width : -1.0;
+    }
+  }
+  S21Matrix rhs = MakeMatrix(size, 1);
+  for (auto _ : state) {
+    S21Matrix result = band.Solve(rhs);
+    benchmark::DoNotOptimize(result);
+  }
+}
+BENCHMARK(BM_BandSolve)->ArgsProduct({{1 << 12, 1 << 16}, {1, 4}});
+
+void BM_TridiagonalBatch(benchmark::State &state) {
+  const int size = 64;
+  const int count = state.range(0);
+  std::vector<double> lower(size * count, -1.0);
+  std::vector<double> diagonal(size * count, 4.0);
+  std::vector<double> upper(size * count, -1.0);
+  std::vector<double> rhs(size * count, 1.0);
+  for (auto _ : state) {
+    std::vector<double> solution = rhs;
+    S21BandMatrix::SolveTridiagonal(size, count, lower.data(),
+                                    diagonal.data(), upper.data(),
+                                    solution.data());
+    benchmark::DoNotOptimize(solution.data());
+  }
+}
+BENCHMARK(BM_TridiagonalBatch)->RangeMultiplier(8)->Range(64, 4096);
+
+// Matrix-free 1D Laplacian with a diagonal shift, arg 1 picks the method.
+void BM_Krylov(benchmark::State &state) {
+  const int size = state.range(0);
+  S21LinearOperator op(size, [size](const double *x, double *y) {
+    for (int i = 0; i < size; ++i) {
+      y[i] = 2.01 * x[i] - (i ? x[i - 1] : 0.0) -
+             (i + 1 < size ? x[i + 1] : 0.0);
+    }
+  });
+  S21KrylovSolver solver(
+      op, static_cast<S21KrylovSolver::Method>(state.range(1)));
+  std::vector<double> rhs(size, 1.0);
+  std::vector<double> solution(size);
+  for (auto _ : state) {
+    std::fill(solution.begin(), solution.end(), 0.0);
+    benchmark::DoNotOptimize(solver.Solve(rhs.data(), solution.data()));
+  }
+}
+BENCHMARK(BM_Krylov)->ArgsProduct({{1 << 12, 1 << 16}, {0, 1, 2}});
+
+void BM_Kronecker(benchmark::State &state) {
+  const int size = state.range(0);
+  S21Matrix lhs(size, size);
+  S21Matrix rhs(size, size);
+  lhs.Fill();
+  rhs.Fill();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs.Kronecker(rhs));
+  }
+}
+BENCHMARK(BM_Kronecker)->RangeMultiplier(4)->Range(8, 32);
+
+// Arg 1 picks exp, tanh or max(0, x).
+void BM_Apply(benchmark::State &state) {
+  const int size = state.range(0);
+  S21Matrix matrix(size, size);
+  std::fill(matrix.begin(), matrix.end(), 0.5);
+  for (auto _ : state) {
+    switch (state.range(1)) {
+      case 0:
+        matrix.Apply(simd::ExpFunction());
+        break;
+      case 1:
+        matrix.Apply(simd::TanhFunction());
+        break;
+      default:
+        matrix.Apply(simd::ReluFunction());
+    }
+    std::fill(matrix.begin(), matrix.end(), 0.5);
+  }
+}
+BENCHMARK(BM_Apply)->ArgsProduct({{64, 1024}, {0, 1, 2}});
+
+// Four independent GEMMs summed pairwise, built and run as one graph.
+void BM_MatrixGraph(benchmark::State &state) {
+  const int size = state.range(0);
+  std::vector<S21Matrix> matrices(8, S21Matrix(size, size));
+  for (auto &matrix : matrices) {
+    matrix.Fill();
+  }
+  for (auto _ : state) {
+    S21MatrixGraph graph;
+    std::vector<S21MatrixGraph::Handle> products;
+    for (int i = 0; i < 8; i += 2) {
+      products.push_back(graph.Mul(graph.Input(matrices[i]),
+                                   graph.Input(matrices[i + 1])));
+    }
+    const auto sum = graph.Sum(graph.Sum(products[0], products[1]),
+                               graph.Sum(products[2], products[3]));
+    benchmark::DoNotOptimize(sum.Get());
+  }
+}
+BENCHMARK(BM_MatrixGraph)->RangeMultiplier(4)->Range(64, 256);
+
+// Arg 1 picks the numa::Placement of the buffer. The product reads every row
+// on the thread that zeroed it under kFirstTouch, and on one node for kLocal,
+// so the gap shows up on multi-socket machines only.
+void BM_NumaPlacement(benchmark::State &state) {
+  const int size = state.range(0);
+  numa::SetPlacement(static_cast<numa::Placement>(state.range(1)));
+  S21Matrix matrix(size, size);
+  numa::SetPlacement(numa::kLocal);
+  matrix.Fill();
+  std::vector<double> x(size, 1.0);
+  std::vector<double> y(size);
+  for (auto _ : state) {
+    matrix.MulVector(x.data(), y.data());
+    benchmark::DoNotOptimize(y.data());
+  }
+  state.SetBytesProcessed(state.iterations() * size * size * sizeof(double));
+}
+BENCHMARK(BM_NumaPlacement)->ArgsProduct({{1 << 12}, {0, 1, 2}});
+
+void BM_FillRandom(benchmark::State &state) {
+  const int size = state.range(0);
+  const auto distribution =
+      static_cast<S21Matrix::Distribution>(state.range(1));
+  S21Matrix matrix(size, size);
+  for (auto _ : state) {
+    matrix.FillRandom(5489, distribution);
+    benchmark::DoNotOptimize(matrix.data());
+  }
+  state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_FillRandom)->ArgsProduct({{256, 2048}, {0, 1}});
+
+// int8 product, arg 1 picks the S21QuantizedMatrix::Kernel. Compare with
+// BM_MulMatrix for the double precision product of the same size.
+void BM_QuantizedMul(benchmark::State &state) {
+  const int size = state.range(0);
+  S21Matrix lhs(size, size);
+  S21Matrix rhs(size, size);
+  lhs.FillRandom(1);
+  rhs.FillRandom(2);
+  const S21QuantizedMatrix a(lhs);
+  const S21QuantizedMatrix b(rhs, S21QuantizedMatrix::kPerColumn);
+  S21QuantizedMatrix::SetKernel(
+      static_cast<S21QuantizedMatrix::Kernel>(state.range(1)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a * b);
+  }
+  S21QuantizedMatrix::SetKernel(S21QuantizedMatrix::SupportedKernel());
+  state.SetItemsProcessed(state.iterations() * 2L * size * size * size);
+}
+BENCHMARK(BM_QuantizedMul)->ArgsProduct({{256, 1024}, {0, 1, 2}});
+
+}  // namespace s21
+
+BENCHMARK_MAIN();
@@ -0,0 +1,297 @@
+#include "s21_band_matrix.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+
+#include "s21_matrix_stats.h"
+#include "s21_parallel.h"
+
+namespace s21 {
+
+S21BandMatrix::S21BandMatrix(const int size, const int lower, const int upper)
+    : size_(size), lower_(lower), upper_(upper) {
+  if (size < 0 || lower < 0 || upper < 0) {
+    throw std::invalid_argument("Constructor: negative size or bandwidth");
+  }
+  data_.assign(static_cast<size_t>(size) * (lower + upper + 1), 0.0);
+}
+
+S21BandMatrix::S21BandMatrix(const S21Matrix& matrix, const int lower,
+                             const int upper)
+    : S21BandMatrix(matrix.get_rows(), lower, upper) {
+  if (matrix.get_rows() != matrix.get_cols()) {
+    throw std::invalid_argument("Constructor: matrix isn't square");
+  }
+  for (int i = 0; i < size_; ++i) {
+    for (int j = std::max(0, i - lower_); j <= std::min(size_ - 1, i + upper_);
+         ++j) {
+      data_[Index(i, j)] = matrix[i][j];
+    }
+  }
+}
+
+int S21BandMatrix::get_size() const noexcept { return size_; }
+
+int S21BandMatrix::get_lower() const noexcept { return lower_; }
+
+int S21BandMatrix::get_upper() const noexcept { return upper_; }
+
+double& S21BandMatrix::operator()(const int row, const int col) {
+  if (row < 1 || col < 1 || row > size_ || col > size_) {
+    throw std::logic_error("(): element doesn't exist");
+  }
+  if (!InBand(row - 1, col - 1)) {
+    throw std::logic_error("(): element isn't stored");
+  }
+  return data_[Index(row - 1, col - 1)];
+}
+
+double S21BandMatrix::operator()(const int row, const int col) const {
+  if (row < 1 || col < 1 || row > size_ || col > size_) {
+    throw std::logic_error("(): element doesn't exist");
+  }
+  return InBand(row - 1, col - 1) ? data_[Index(row - 1, col - 1)] : 0.0;
+}
+
+S21Matrix S21BandMatrix::ToMatrix() const {
+  S21Matrix result(size_);
+  for (int i = 0; i < size_; ++i) {
+    for (int j = std::max(0, i - lower_); j <= std::min(size_ - 1, i + upper_);
+         ++j) {
+      result[i][j] = data_[Index(i, j)];
+    }
+  }
+  return result;
+}
+
+// y = A * x for vectors of get_size() elements.
+void S21BandMatrix::MulVector(const double* x, double* y) const {
+  S21_STATS_OPERATION(stats::kBandMul, 2.0 * data_.size());
+  const int width = lower_ + upper_ + 1;
+  const int grain = std::max(1, (1 << 16) / (2 * width));
+  parallel::For(0, size_, grain, [&](const int first, const int last) {
+    for (int i = first; i < last; ++i) {
+      const int begin = std::max(0, i - lower_);
+      const int end = std::min(size_ - 1, i + upper_);
+      const double* row = data_.data() + Index(i, 0);
+      double sum = 0.0;
+      for (int j = begin; j <= end; ++j) {
+        sum += row[j] * x[j];
+      }
+      y[i] = sum;
+    }
+  });
+}
+
+S21Matrix S21BandMatrix::operator*(const S21Matrix& rhs) const {
+  if (rhs.get_rows() != size_) {
+    throw std::logic_error("Band: M1(cols) != M2(rows)");
+  }
+  const int cols = rhs.get_cols();
+  S21_STATS_OPERATION(stats::kBandMul, 2.0 * data_.size() * cols);
+  S21Matrix result(size_, cols);
+  const double* in = rhs.data();
+  double* out = result.data();
+  const long work = static_cast<long>(lower_ + upper_ + 1) * cols;
+  const int grain = static_cast<int>(std::max(1L, (1L << 16) / (work + 1)));
+  parallel::For(0, size_, grain, [&](const int first, const int last) {
+    for (int i = first; i < last; ++i) {
+      double* target = out + static_cast<size_t>(i) * cols;
+      for (int k = std::max(0, i - lower_);
+           k <= std::min(size_ - 1, i + upper_); ++k) {
+        const double value = data_[Index(i, k)];
+        const double* source = in + static_cast<size_t>(k) * cols;
+        for (int j = 0; j < cols; ++j) {
+          target[j] += value * source[j];
+        }
+      }
+    }
+  });
+  return result;
+}
+
+// Tridiagonal matrices go through the Thomas algorithm, anything else or a
+// tridiagonal matrix that needs pivoting through banded LU.
+S21Matrix S21BandMatrix::Solve(const S21Matrix& rhs) const {
+  if (rhs.get_rows() != size_) {
+    throw std::logic_error("Band: rhs(rows) != matrix(rows)");
+  }
+  if (!size_) {
+    throw std::logic_error("Band: operation with NULL matrix");
+  }
+  S21Matrix result{rhs};
+  const int cols = result.get_cols();
+  if (lower_ != 1 || upper_ != 1 || !SolveThomas(result.data(), cols)) {
+    SolveLU(result.data(), cols);
+  }
+  return result;
+}
+
+// Solves count independent tridiagonal systems of the given size, system s
+// uses lower, diagonal, upper and rhs starting at s * size; lower[0] and
+// upper[size - 1] of every system are ignored. The solutions overwrite rhs.
+// The systems are split between threads and must not need pivoting; every
+// pivot is checked before rhs is written, so a throw leaves rhs unchanged.
+void S21BandMatrix::SolveTridiagonal(const int size, const int count,
+                                     const double* lower,
+                                     const double* diagonal,
+                                     const double* upper, double* rhs) {
+  if (size < 1 || count < 0) {
+    throw std::logic_error("Band: invalid tridiagonal batch");
+  }
+  S21_STATS_OPERATION(stats::kBandSolve, 8.0 * size * count);
+  std::vector<double> factors(static_cast<size_t>(size) * count);
+  std::atomic<bool> singular{false};
+  const int grain = std::max(1, (1 << 14) / size);
+  parallel::For(0, count, grain, [&](const int first, const int last) {
+    for (int s = first; s < last && !singular; ++s) {
+      const size_t offset = static_cast<size_t>(s) * size;
+      const double* a = lower + offset;
+      const double* b = diagonal + offset;
+      const double* c = upper + offset;
+      double* f = factors.data() + offset;
+      for (int i = 0; i < size; ++i) {
+        const double denominator = b[i] - (i ? a[i] * f[i - 1] : 0.0);
+        if (denominator == 0.0) {
+          singular = true;
+          break;
+        }
+        f[i] = i + 1 < size ? c[i] / denominator : 0.0;
+      }
+    }
+  });
+  if (singular) {
+    throw std::logic_error("Band: tridiagonal system needs pivoting");
+  }
+  parallel::For(0, count, grain, [&](const int first, const int last) {
+    for (int s = first; s < last; ++s) {
+      const size_t offset = static_cast<size_t>(s) * size;
+      const double* a = lower + offset;
+      const double* b = diagonal + offset;
+      const double* f = factors.data() + offset;
+      double* d = rhs + offset;
+      for (int i = 0; i < size; ++i) {
+        const double denominator = b[i] - (i ? a[i] * f[i - 1] : 0.0);
+        d[i] = (d[i] - (i ? a[i] * d[i - 1] : 0.0)) / denominator;
+      }
+      for (int i = size - 2; i >= 0; --i) {
+        d[i] -= f[i] * d[i + 1];
+      }
+    }
+  });
+}
+
+size_t S21BandMatrix::Index(const int row, const int col) const noexcept {
+  return static_cast<size_t>(row) * (lower_ + upper_ + 1) + col - row + lower_;
+}
+
+bool S21BandMatrix::InBand(const int row, const int col) const noexcept {
+  return col >= row - lower_ && col <= row + upper_;
+}
+
+// Thomas algorithm for a tridiagonal matrix. The pivots are checked before rhs
+// is touched, false means a zero pivot and rhs is left unchanged.
+bool S21BandMatrix::SolveThomas(double* rhs, const int cols) const {
+  std::vector<double> factors(size_);
+  std::vector<double> inverse(size_);
+  for (int i = 0; i < size_; ++i) {
+    const double denominator =
+        data_[Index(i, i)] - (i ? data_[Index(i, i - 1)] * factors[i - 1] : 0);
+    if (!denominator) {
+      return false;
+    }
+    inverse[i] = 1.0 / denominator;
+    factors[i] = i + 1 < size_ ? data_[Index(i, i + 1)] * inverse[i] : 0.0;
+  }
+  S21_STATS_OPERATION(stats::kBandSolve, 5.0 * size_ * cols);
+  for (int j = 0; j < cols; ++j) {
+    rhs[j] *= inverse[0];
+  }
+  for (int i = 1; i < size_; ++i) {
+    double* row = rhs + static_cast<size_t>(i) * cols;
+    const double* previous = row - cols;
+    const double sub = data_[Index(i, i - 1)];
+    for (int j = 0; j < cols; ++j) {
+      row[j] = (row[j] - sub * previous[j]) * inverse[i];
+    }
+  }
+  for (int i = size_ - 2; i >= 0; --i) {
+    double* row = rhs + static_cast<size_t>(i) * cols;
+    const double* next = row + cols;
+    for (int j = 0; j < cols; ++j) {
+      row[j] -= factors[i] * next[j];
+    }
+  }
+  return true;
+}
+
+// Banded LU with partial pivoting applied to rhs on the fly. Row swaps widen
+// the upper bandwidth to lower + upper, so the factors live in a copy with
+// that extra room.
+void S21BandMatrix::SolveLU(double* rhs, const int cols) const {
+  const int band = lower_ + upper_;
+  const int width = lower_ + band + 1;
+  S21_STATS_OPERATION(stats::kBandSolve,
+                      2.0 * size_ * (lower_ + 1) * (band + 1 + cols));
+  std::vector<double> factors(static_cast<size_t>(size_) * width, 0.0);
+  auto at = [&factors, width, this](const int row, const int col) -> double& {
+    return factors[static_cast<size_t>(row) * width + col - row + lower_];
+  };
+  for (int i = 0; i < size_; ++i) {
+    for (int j = std::max(0, i - lower_); j <= std::min(size_ - 1, i + upper_);
+         ++j) {
+      at(i, j) = data_[Index(i, j)];
+    }
+  }
+  for (int k = 0; k < size_; ++k) {
+    const int last_row = std::min(size_ - 1, k + lower_);
+    const int last_col = std::min(size_ - 1, k + band);
+    int pivot = k;
+    for (int i = k + 1; i <= last_row; ++i) {
+      if (fabs(at(i, k)) > fabs(at(pivot, k))) {
+        pivot = i;
+      }
+    }
+    if (!at(pivot, k)) {
+      throw std::logic_error("Determinant is zero");
+    }
+    if (pivot != k) {
+      for (int j = k; j <= last_col; ++j) {
+        std::swap(at(k, j), at(pivot, j));
+      }
+      std::swap_ranges(rhs + static_cast<size_t>(k) * cols,
+                       rhs + static_cast<size_t>(k + 1) * cols,
+                       rhs + static_cast<size_t>(pivot) * cols);
+    }
+    const double* source = rhs + static_cast<size_t>(k) * cols;
+    for (int i = k + 1; i <= last_row; ++i) {
+      const double factor = at(i, k) / at(k, k);
+      for (int j = k + 1; j <= last_col; ++j) {
+        at(i, j) -= factor * at(k, j);
+      }
+      double* target = rhs + static_cast<size_t>(i) * cols;
+      for (int j = 0; j < cols; ++j) {
+        target[j] -= factor * source[j];
+      }
+    }
+  }
+  for (int i = size_ - 1; i >= 0; --i) {
+    double* target = rhs + static_cast<size_t>(i) * cols;
+    for (int k = i + 1; k <= std::min(size_ - 1, i + band); ++k) {
+      const double factor = at(i, k);
+      const double* source = rhs + static_cast<size_t>(k) * cols;
+      for (int j = 0; j < cols; ++j) {
+        target[j] -= factor * source[j];
+      }
+    }
+    const double scale = 1.0 / at(i, i);
+    for (int j = 0; j < cols; ++j) {
+      target[j] *= scale;
+    }
+  }
+}
+
+}  // namespace s21
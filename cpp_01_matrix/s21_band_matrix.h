@@ -0,0 +1,47 @@
+#ifndef CPP1_S21_MATRIXPLUS_4_S21_BAND_MATRIX_H_
+#define CPP1_S21_MATRIXPLUS_4_S21_BAND_MATRIX_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+namespace s21 {
+
+// Square matrix with `lower` subdiagonals and `upper` superdiagonals. Every
+// row keeps lower + upper + 1 values, so storage and all operations are
+// linear in the size for a fixed bandwidth. Indices are 1-based like in
+// S21Matrix; the non-const operator() only reaches elements inside the band.
+class S21BandMatrix {
+ public:
+  S21BandMatrix(const int size, const int lower, const int upper);
+  S21BandMatrix(const S21Matrix &matrix, const int lower, const int upper);
+
+  int get_size() const noexcept;
+  int get_lower() const noexcept;
+  int get_upper() const noexcept;
+  double &operator()(const int row, const int col);
+  double operator()(const int row, const int col) const;
+
+  S21Matrix ToMatrix() const;
+  void MulVector(const double *x, double *y) const;
+  S21Matrix operator*(const S21Matrix &rhs) const;
+  S21Matrix Solve(const S21Matrix &rhs) const;
+
+  static void SolveTridiagonal(const int size, const int count,
+                               const double *lower, const double *diagonal,
+                               const double *upper, double *rhs);
+
+ private:
+  size_t Index(const int row, const int col) const noexcept;
+  bool InBand(const int row, const int col) const noexcept;
+  bool SolveThomas(double *rhs, const int cols) const;
+  void SolveLU(double *rhs, const int cols) const;
+  std::vector<double> data_;
+  int size_{0};
+  int lower_{0};
+  int upper_{0};
+};
+
+}  // namespace s21
+
+#endif  // CPP1_S21_MATRIXPLUS_4_S21_BAND_MATRIX_H_
@@ -0,0 +1,166 @@
+#include "s21_inverse_updater.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "s21_lu.h"
+#include "s21_parallel.h"
+
+namespace s21 {
+
+S21InverseUpdater::S21InverseUpdater(const S21Matrix& matrix,
+                                     const double tolerance)
+    : tolerance_(tolerance), size_(matrix.get_rows()) {
+  Reset(S21Matrix{matrix});
+  refactorizations_ = 0;
+}
+
+const S21Matrix& S21InverseUpdater::get_matrix() const noexcept {
+  return matrix_;
+}
+
+const S21Matrix& S21InverseUpdater::get_inverse() const noexcept {
+  return inverse_;
+}
+
+double S21InverseUpdater::get_determinant() const noexcept {
+  return determinant_;
+}
+
+int S21InverseUpdater::get_refactorizations() const noexcept {
+  return refactorizations_;
+}
+
+void S21InverseUpdater::RankOneUpdate(const S21Matrix& u, const S21Matrix& v) {
+  CheckVector(u);
+  CheckVector(v);
+  ApplyRankOne(u.data(), v.data());
+}
+
+// A + U V^T with U, V of size n x k:
+// (A + U V^T)^-1 = A^-1 - A^-1 U (I + V^T A^-1 U)^-1 V^T A^-1.
+void S21InverseUpdater::RankUpdate(const S21Matrix& u, const S21Matrix& v) {
+  if (u.get_rows() != size_ || v.get_rows() != size_ ||
+      u.get_cols() != v.get_cols() || !u.get_cols()) {
+    throw std::logic_error("RankUpdate: U and V must be n x k");
+  }
+  const int rank = u.get_cols();
+  S21Matrix inverse_u = inverse_ * u;
+  S21Matrix v_transposed = v.Transpose();
+  S21Matrix capacitance = v_transposed * inverse_u;
+  for (int i = 0; i < rank; ++i) {
+    capacitance[i][i] += 1.0;
+  }
+  S21LU lu(capacitance);
+  double largest = 0.0;
+  double smallest = INFINITY;
+  for (int i = 0; i < rank; ++i) {
+    const double pivot = fabs(lu.get_factors()[i][i]);
+    largest = std::max(largest, pivot);
+    smallest = std::min(smallest, pivot);
+  }
+  S21Matrix updated = u * v_transposed;
+  updated += matrix_;
+  if (lu.IsSingular() || smallest <= tolerance_ * std::max(1.0, largest)) {
+    Reset(std::move(updated));
+    return;
+  }
+  S21Matrix correction = inverse_u * lu.Solve(v_transposed * inverse_);
+  inverse_ -= correction;
+  matrix_ = std::move(updated);
+  determinant_ *= lu.Determinant();
+}
+
+void S21InverseUpdater::ReplaceRow(const int row, const S21Matrix& values) {
+  CheckVector(values);
+  if (row < 1 || row > size_) {
+    throw std::logic_error("ReplaceRow: row doesn't exist");
+  }
+  std::vector<double> u(size_);
+  std::vector<double> v(size_);
+  u[row - 1] = 1.0;
+  for (int j = 0; j < size_; ++j) {
+    v[j] = values.data()[j] - matrix_[row - 1][j];
+  }
+  ApplyRankOne(u.data(), v.data());
+}
+
+void S21InverseUpdater::ReplaceColumn(const int col, const S21Matrix& values) {
+  CheckVector(values);
+  if (col < 1 || col > size_) {
+    throw std::logic_error("ReplaceColumn: column doesn't exist");
+  }
+  std::vector<double> u(size_);
+  std::vector<double> v(size_);
+  v[col - 1] = 1.0;
+  for (int i = 0; i < size_; ++i) {
+    u[i] = values.data()[i] - matrix_[i][col - 1];
+  }
+  ApplyRankOne(u.data(), v.data());
+}
+
+void S21InverseUpdater::Refactorize() { Reset(S21Matrix{matrix_}); }
+
+// A + u v^T: w = A^-1 u, z = A^-T v, the inverse loses w z^T / (1 + v^T w)
+// and the determinant is multiplied by 1 + v^T w.
+void S21InverseUpdater::ApplyRankOne(const double* u, const double* v) {
+  std::vector<double> w(size_);
+  std::vector<double> z(size_);
+  inverse_.MulVector(u, w.data());
+  inverse_.MulVector(v, z.data(), true);
+  double projection = 0.0;
+  for (int i = 0; i < size_; ++i) {
+    projection += v[i] * w[i];
+  }
+  const double denominator = 1.0 + projection;
+  if (fabs(denominator) <= tolerance_ * std::max(1.0, fabs(projection))) {
+    S21Matrix updated{matrix_};
+    for (int i = 0; i < size_; ++i) {
+      for (int j = 0; j < size_; ++j) {
+        updated[i][j] += u[i] * v[j];
+      }
+    }
+    Reset(std::move(updated));
+    return;
+  }
+  for (int i = 0; i < size_; ++i) {
+    double* row = matrix_[i];
+    for (int j = 0; j < size_; ++j) {
+      row[j] += u[i] * v[j];
+    }
+  }
+  const int grain = std::max(1, (1 << 14) / size_);
+  parallel::For(0, size_, grain, [&](const int first, const int last) {
+    for (int i = first; i < last; ++i) {
+      double* row = inverse_[i];
+      const double factor = w[i] / denominator;
+      for (int j = 0; j < size_; ++j) {
+        row[j] -= factor * z[j];
+      }
+    }
+  });
+  determinant_ *= denominator;
+}
+
+// Factorizes the new matrix first so a singular update leaves the state
+// untouched.
+void S21InverseUpdater::Reset(S21Matrix&& matrix) {
+  S21LU lu(matrix);
+  inverse_ = lu.Inverse();
+  determinant_ = lu.Determinant();
+  matrix_ = std::move(matrix);
+  matrix_.set_copy_on_write(false);
+  ++refactorizations_;
+}
+
+void S21InverseUpdater::CheckVector(const S21Matrix& vector) const {
+  if (std::min(vector.get_rows(), vector.get_cols()) != 1 ||
+      std::max(vector.get_rows(), vector.get_cols()) != size_) {
+    throw std::logic_error("Inverse update: vector of wrong size");
+  }
+}
+
+}  // namespace s21
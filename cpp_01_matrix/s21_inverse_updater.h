@@ -0,0 +1,42 @@
+#ifndef CPP1_S21_MATRIXPLUS_4_S21_INVERSE_UPDATER_H_
+#define CPP1_S21_MATRIXPLUS_4_S21_INVERSE_UPDATER_H_
+
+#include "s21_matrix_oop.h"
+
+namespace s21 {
+
+// Keeps the inverse and the determinant of a matrix in sync with low-rank
+// changes: O(n^2) per rank-one update (Sherman-Morrison), O(n^2 k + k^3) per
+// rank-k update (Woodbury). When the capacitance term is badly conditioned
+// the inverse is recomputed from the updated matrix instead.
+class S21InverseUpdater {
+ public:
+  explicit S21InverseUpdater(const S21Matrix &matrix,
+                             const double tolerance = kDefaultTolerance);
+  const S21Matrix &get_matrix() const noexcept;
+  const S21Matrix &get_inverse() const noexcept;
+  double get_determinant() const noexcept;
+  int get_refactorizations() const noexcept;
+  void RankOneUpdate(const S21Matrix &u, const S21Matrix &v);
+  void RankUpdate(const S21Matrix &u, const S21Matrix &v);
+  void ReplaceRow(const int row, const S21Matrix &values);
+  void ReplaceColumn(const int col, const S21Matrix &values);
+  void Refactorize();
+
+  static constexpr double kDefaultTolerance = 1e-8;
+
+ private:
+  void ApplyRankOne(const double *u, const double *v);
+  void Reset(S21Matrix &&matrix);
+  void CheckVector(const S21Matrix &vector) const;
+  S21Matrix matrix_;
+  S21Matrix inverse_;
+  double determinant_{0.0};
+  double tolerance_{kDefaultTolerance};
+  int size_{0};
+  int refactorizations_{0};
+};
+
+}  // namespace s21
+
+#endif  // CPP1_S21_MATRIXPLUS_4_S21_INVERSE_UPDATER_H_
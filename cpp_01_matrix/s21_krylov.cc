@@ -0,0 +1,463 @@
+#include "s21_krylov.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_parallel.h"
+
+namespace s21 {
+
+namespace {
+
+constexpr int kVectorGrain = 1 << 14;
+
+template <typename Function>
+void ForEach(const int size, Function&& function) {
+  parallel::For(0, size, kVectorGrain, [&](const int first, const int last) {
+    for (int i = first; i < last; ++i) {
+      function(i);
+    }
+  });
+}
+
+// Incomplete LU without fill-in, the factors keep the sparsity pattern of the
+// nonzero elements of the matrix in compressed rows.
+struct ILUFactors {
+  std::vector<int> starts;
+  std::vector<int> cols;
+  std::vector<double> values;
+  std::vector<int> diagonal;
+};
+
+std::shared_ptr<const ILUFactors> FactorILU0(const S21Matrix& matrix) {
+  const int size = matrix.get_rows();
+  auto factors = std::make_shared<ILUFactors>();
+  factors->starts.push_back(0);
+  factors->diagonal.assign(size, -1);
+  for (int i = 0; i < size; ++i) {
+    for (int j = 0; j < size; ++j) {
+      if (matrix[i][j] || i == j) {
+        if (i == j) {
+          factors->diagonal[i] = static_cast<int>(factors->cols.size());
+        }
+        factors->cols.push_back(j);
+        factors->values.push_back(matrix[i][j]);
+      }
+    }
+    factors->starts.push_back(static_cast<int>(factors->cols.size()));
+  }
+  std::vector<int> position(size, -1);
+  std::vector<double>& values = factors->values;
+  for (int i = 0; i < size; ++i) {
+    const int row_first = factors->starts[i];
+    const int row_last = factors->starts[i + 1];
+    for (int p = row_first; p < row_last; ++p) {
+      position[factors->cols[p]] = p;
+    }
+    for (int p = row_first; p < factors->diagonal[i]; ++p) {
+      const int k = factors->cols[p];
+      const double pivot = values[factors->diagonal[k]];
+      if (!pivot) {
+        throw std::logic_error("ILU0: zero pivot");
+      }
+      values[p] /= pivot;
+      for (int q = factors->diagonal[k] + 1; q < factors->starts[k + 1]; ++q) {
+        if (position[factors->cols[q]] >= 0) {
+          values[position[factors->cols[q]]] -= values[p] * values[q];
+        }
+      }
+    }
+    for (int p = row_first; p < row_last; ++p) {
+      position[factors->cols[p]] = -1;
+    }
+    if (!values[factors->diagonal[i]]) {
+      throw std::logic_error("ILU0: zero pivot");
+    }
+  }
+  return factors;
+}
+
+void CheckOperator(const S21Matrix& matrix) {
+  if (!matrix.get_rows()) {
+    throw std::logic_error("Operation with NULL mattrix");
+  }
+  if (matrix.get_rows() != matrix.get_cols()) {
+    throw std::logic_error("Matirx isn't square");
+  }
+}
+
+}  // namespace
+
+S21LinearOperator::S21LinearOperator(const S21Matrix& matrix)
+    : size_(matrix.get_rows()) {
+  CheckOperator(matrix);
+  const S21Matrix* source = &matrix;
+  callback_ = [source](const double* x, double* y) {
+    source->MulVector(x, y);
+  };
+}
+
+S21LinearOperator::S21LinearOperator(const int size, Callback callback)
+    : size_(size), callback_(std::move(callback)) {
+  if (size < 1 || !callback_) {
+    throw std::invalid_argument("Constructor: invalid linear operator");
+  }
+}
+
+int S21LinearOperator::get_size() const noexcept { return size_; }
+
+void S21LinearOperator::Apply(const double* x, double* y) const {
+  callback_(x, y);
+}
+
+S21LinearOperator S21LinearOperator::Identity(const int size) {
+  return S21LinearOperator(size, [size](const double* x, double* y) {
+    ForEach(size, [x, y](const int i) { y[i] = x[i]; });
+  });
+}
+
+S21LinearOperator S21LinearOperator::Jacobi(const S21Matrix& matrix) {
+  CheckOperator(matrix);
+  const int size = matrix.get_rows();
+  auto inverse = std::make_shared<std::vector<double>>(size);
+  for (int i = 0; i < size; ++i) {
+    if (!matrix[i][i]) {
+      throw std::logic_error("Jacobi: zero diagonal element");
+    }
+    (*inverse)[i] = 1.0 / matrix[i][i];
+  }
+  return S21LinearOperator(size, [size, inverse](const double* x, double* y) {
+    const double* scale = inverse->data();
+    ForEach(size, [x, y, scale](const int i) { y[i] = scale[i] * x[i]; });
+  });
+}
+
+S21LinearOperator S21LinearOperator::ILU0(const S21Matrix& matrix) {
+  CheckOperator(matrix);
+  const int size = matrix.get_rows();
+  std::shared_ptr<const ILUFactors> factors = FactorILU0(matrix);
+  return S21LinearOperator(size, [size, factors](const double* x, double* y) {
+    const std::vector<double>& values = factors->values;
+    for (int i = 0; i < size; ++i) {
+      double sum = x[i];
+      for (int p = factors->starts[i]; p < factors->diagonal[i]; ++p) {
+        sum -= values[p] * y[factors->cols[p]];
+      }
+      y[i] = sum;
+    }
+    for (int i = size - 1; i >= 0; --i) {
+      double sum = y[i];
+      for (int p = factors->diagonal[i] + 1; p < factors->starts[i + 1]; ++p) {
+        sum -= values[p] * y[factors->cols[p]];
+      }
+      y[i] = sum / values[factors->diagonal[i]];
+    }
+  });
+}
+
+S21KrylovSolver::S21KrylovSolver(const S21LinearOperator& matrix,
+                                 const Method method)
+    : matrix_(matrix),
+      preconditioner_(S21LinearOperator::Identity(matrix.get_size())),
+      method_(method) {
+  Allocate();
+}
+
+void S21KrylovSolver::set_preconditioner(
+    const S21LinearOperator& preconditioner) {
+  if (preconditioner.get_size() != matrix_.get_size()) {
+    throw std::logic_error("Krylov: preconditioner size != matrix size");
+  }
+  preconditioner_ = preconditioner;
+}
+
+void S21KrylovSolver::set_tolerance(const double tolerance) {
+  if (!(tolerance > 0.0)) {
+    throw std::logic_error("Krylov: tolerance must be positive");
+  }
+  tolerance_ = tolerance;
+}
+
+void S21KrylovSolver::set_max_iterations(const int iterations) {
+  if (iterations < 1) {
+    throw std::logic_error("Krylov: iterations must be positive");
+  }
+  max_iterations_ = iterations;
+}
+
+void S21KrylovSolver::set_restart(const int restart) {
+  if (restart < 1) {
+    throw std::logic_error("Krylov: restart must be positive");
+  }
+  restart_ = restart;
+  Allocate();
+}
+
+int S21KrylovSolver::get_iterations() const noexcept { return iterations_; }
+
+double S21KrylovSolver::get_residual() const noexcept { return residual_; }
+
+// x holds the initial guess on entry and the solution on exit. Returns
+// whether the tolerance was reached within the iteration limit.
+bool S21KrylovSolver::Solve(const double* b, double* x) {
+  const int size = matrix_.get_size();
+  iterations_ = 0;
+  const double norm = Norm(b);
+  if (!norm) {
+    ForEach(size, [x](const int i) { x[i] = 0.0; });
+    residual_ = 0.0;
+    return true;
+  }
+  residual_ = 1.0;
+  const double target = tolerance_ * norm;
+  bool converged = false;
+  if (method_ == kCG) {
+    converged = SolveCG(b, x, target);
+  } else if (method_ == kBiCGSTAB) {
+    converged = SolveBiCGSTAB(b, x, target);
+  } else {
+    converged = SolveGMRES(b, x, target);
+  }
+  residual_ /= norm;
+  return converged;
+}
+
+S21Matrix S21KrylovSolver::Solve(const S21Matrix& b) {
+  if (b.get_rows() != matrix_.get_size() || b.get_cols() != 1) {
+    throw std::logic_error("Krylov: rhs must be a column of matrix size");
+  }
+  S21Matrix result(b.get_rows(), 1);
+  if (!Solve(b.data(), result.data())) {
+    throw std::runtime_error("Krylov: no convergence");
+  }
+  return result;
+}
+
+void S21KrylovSolver::Allocate() {
+  const int vectors =
+      method_ == kCG ? 4 : method_ == kBiCGSTAB ? 8 : restart_ + 3;
+  workspace_.assign(static_cast<size_t>(vectors) * matrix_.get_size(), 0.0);
+  hessenberg_.assign(
+      method_ == kGMRES ? static_cast<size_t>(restart_ + 4) * (restart_ + 1)
+                        : 0,
+      0.0);
+  partials_.assign((matrix_.get_size() + kVectorGrain - 1) / kVectorGrain,
+                   0.0);
+}
+
+double* S21KrylovSolver::Vector(const int index) noexcept {
+  return workspace_.data() + static_cast<size_t>(index) * matrix_.get_size();
+}
+
+// Chunks have a fixed size and are summed in order, so the result does not
+// depend on the number of threads.
+double S21KrylovSolver::Dot(const double* lhs, const double* rhs) {
+  const int size = matrix_.get_size();
+  const int chunks = static_cast<int>(partials_.size());
+  parallel::For(0, chunks, 1, [&](const int first, const int last) {
+    for (int chunk = first; chunk < last; ++chunk) {
+      const int end = std::min(size, (chunk + 1) * kVectorGrain);
+      double sum = 0.0;
+      for (int i = chunk * kVectorGrain; i < end; ++i) {
+        sum += lhs[i] * rhs[i];
+      }
+      partials_[chunk] = sum;
+    }
+  });
+  double result = 0.0;
+  for (double value : partials_) {
+    result += value;
+  }
+  return result;
+}
+
+double S21KrylovSolver::Norm(const double* values) {
+  return sqrt(Dot(values, values));
+}
+
+// Preconditioned conjugate gradients, the operator and the preconditioner
+// must be symmetric positive definite.
+bool S21KrylovSolver::SolveCG(const double* b, double* x,
+                              const double target) {
+  const int size = matrix_.get_size();
+  double* r = Vector(0);
+  double* z = Vector(1);
+  double* p = Vector(2);
+  double* q = Vector(3);
+  matrix_.Apply(x, q);
+  ForEach(size, [r, b, q](const int i) { r[i] = b[i] - q[i]; });
+  residual_ = Norm(r);
+  preconditioner_.Apply(r, z);
+  ForEach(size, [p, z](const int i) { p[i] = z[i]; });
+  double rz = Dot(r, z);
+  while (residual_ > target && iterations_ < max_iterations_) {
+    matrix_.Apply(p, q);
+    const double curvature = Dot(p, q);
+    if (!curvature) {
+      break;
+    }
+    const double alpha = rz / curvature;
+    ForEach(size, [=](const int i) {
+      x[i] += alpha * p[i];
+      r[i] -= alpha * q[i];
+    });
+    ++iterations_;
+    residual_ = Norm(r);
+    preconditioner_.Apply(r, z);
+    const double next = Dot(r, z);
+    const double beta = next / rz;
+    rz = next;
+    ForEach(size, [p, z, beta](const int i) { p[i] = z[i] + beta * p[i]; });
+  }
+  return residual_ <= target;
+}
+
+// Right-preconditioned BiCGSTAB for general nonsymmetric operators.
+bool S21KrylovSolver::SolveBiCGSTAB(const double* b, double* x,
+                                    const double target) {
+  const int size = matrix_.get_size();
+  double* r = Vector(0);
+  double* shadow = Vector(1);
+  double* p = Vector(2);
+  double* v = Vector(3);
+  double* s = Vector(4);
+  double* t = Vector(5);
+  double* p_hat = Vector(6);
+  double* s_hat = Vector(7);
+  matrix_.Apply(x, v);
+  ForEach(size, [=](const int i) {
+    r[i] = b[i] - v[i];
+    shadow[i] = r[i];
+    p[i] = 0.0;
+    v[i] = 0.0;
+  });
+  residual_ = Norm(r);
+  double rho = 1.0;
+  double alpha = 1.0;
+  double omega = 1.0;
+  while (residual_ > target && iterations_ < max_iterations_) {
+    const double next = Dot(shadow, r);
+    if (!next || !omega) {
+      break;
+    }
+    const double beta = next / rho * (alpha / omega);
+    rho = next;
+    ForEach(size, [=](const int i) {
+      p[i] = r[i] + beta * (p[i] - omega * v[i]);
+    });
+    preconditioner_.Apply(p, p_hat);
+    matrix_.Apply(p_hat, v);
+    const double projection = Dot(shadow, v);
+    if (!projection) {
+      break;
+    }
+    alpha = rho / projection;
+    ForEach(size, [=](const int i) { s[i] = r[i] - alpha * v[i]; });
+    ++iterations_;
+    residual_ = Norm(s);
+    if (residual_ <= target) {
+      ForEach(size, [=](const int i) { x[i] += alpha * p_hat[i]; });
+      break;
+    }
+    preconditioner_.Apply(s, s_hat);
+    matrix_.Apply(s_hat, t);
+    const double energy = Dot(t, t);
+    omega = energy ? Dot(t, s) / energy : 0.0;
+    ForEach(size, [=](const int i) {
+      x[i] += alpha * p_hat[i] + omega * s_hat[i];
+      r[i] = s[i] - omega * t[i];
+    });
+    residual_ = Norm(r);
+  }
+  return residual_ <= target;
+}
+
+// Right-preconditioned GMRES(restart) with modified Gram-Schmidt and Givens
+// rotations, the residual norm of every step comes from the rotated rhs.
+bool S21KrylovSolver::SolveGMRES(const double* b, double* x,
+                                 const double target) {
+  const int size = matrix_.get_size();
+  const int m = restart_;
+  double* w = Vector(m + 1);
+  double* u = Vector(m + 2);
+  double* h = hessenberg_.data();
+  double* cs = h + static_cast<size_t>(m + 1) * m;
+  double* sn = cs + m + 1;
+  double* g = sn + m + 1;
+  double* y = g + m + 1;
+  auto at = [h, m](const int row, const int col) -> double& {
+    return h[static_cast<size_t>(row) * m + col];
+  };
+  while (true) {
+    matrix_.Apply(x, w);
+    double* v0 = Vector(0);
+    ForEach(size, [=](const int i) { v0[i] = b[i] - w[i]; });
+    residual_ = Norm(v0);
+    if (residual_ <= target || iterations_ >= max_iterations_) {
+      break;
+    }
+    const double inverse = 1.0 / residual_;
+    ForEach(size, [=](const int i) { v0[i] *= inverse; });
+    std::fill(g, g + m + 1, 0.0);
+    g[0] = residual_;
+    int steps = 0;
+    while (steps < m && iterations_ < max_iterations_ && residual_ > target) {
+      const int j = steps;
+      preconditioner_.Apply(Vector(j), u);
+      matrix_.Apply(u, w);
+      for (int i = 0; i <= j; ++i) {
+        const double* basis = Vector(i);
+        const double dot = Dot(w, basis);
+        at(i, j) = dot;
+        ForEach(size, [=](const int k) { w[k] -= dot * basis[k]; });
+      }
+      const double next = Norm(w);
+      at(j + 1, j) = next;
+      if (next) {
+        double* basis = Vector(j + 1);
+        ForEach(size, [=](const int k) { basis[k] = w[k] / next; });
+      }
+      for (int i = 0; i < j; ++i) {
+        const double top = at(i, j);
+        at(i, j) = cs[i] * top + sn[i] * at(i + 1, j);
+        at(i + 1, j) = -sn[i] * top + cs[i] * at(i + 1, j);
+      }
+      const double radius = hypot(at(j, j), at(j + 1, j));
+      cs[j] = radius ? at(j, j) / radius : 1.0;
+      sn[j] = radius ? at(j + 1, j) / radius : 0.0;
+      at(j, j) = radius;
+      at(j + 1, j) = 0.0;
+      g[j + 1] = -sn[j] * g[j];
+      g[j] *= cs[j];
+      residual_ = fabs(g[j + 1]);
+      ++iterations_;
+      ++steps;
+      if (!next) {
+        break;
+      }
+    }
+    for (int i = steps - 1; i >= 0; --i) {
+      double sum = g[i];
+      for (int k = i + 1; k < steps; ++k) {
+        sum -= at(i, k) * y[k];
+      }
+      y[i] = at(i, i) ? sum / at(i, i) : 0.0;
+    }
+    ForEach(size, [=](const int k) {
+      double sum = 0.0;
+      for (int i = 0; i < steps; ++i) {
+        sum += Vector(i)[k] * y[i];
+      }
+      w[k] = sum;
+    });
+    preconditioner_.Apply(w, u);
+    ForEach(size, [=](const int k) { x[k] += u[k]; });
+  }
+  return residual_ <= target;
+}
+
+}  // namespace s21
@@ -0,0 +1,81 @@
+#ifndef CPP1_S21_MATRIXPLUS_4_S21_KRYLOV_H_
+#define CPP1_S21_MATRIXPLUS_4_S21_KRYLOV_H_
+
+#include <functional>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+namespace s21 {
+
+// Square linear operator y = A * x on vectors of get_size() elements, backed
+// by a dense matrix (held by reference) or by an arbitrary callback. The
+// preconditioners are operators too and approximate A^-1.
+class S21LinearOperator {
+ public:
+  using Callback = std::function<void(const double *x, double *y)>;
+
+  explicit S21LinearOperator(const S21Matrix &matrix);
+  explicit S21LinearOperator(S21Matrix &&matrix) = delete;
+  S21LinearOperator(const int size, Callback callback);
+
+  int get_size() const noexcept;
+  void Apply(const double *x, double *y) const;
+
+  static S21LinearOperator Identity(const int size);
+  static S21LinearOperator Jacobi(const S21Matrix &matrix);
+  static S21LinearOperator ILU0(const S21Matrix &matrix);
+
+ private:
+  int size_{0};
+  Callback callback_;
+};
+
+// Preconditioned Krylov solver for A * x = b. Workspaces are allocated once
+// per solver, so repeated solves with the same operator do not allocate.
+// Convergence means ||b - A * x|| <= tolerance * ||b||.
+class S21KrylovSolver {
+ public:
+  enum Method { kCG, kBiCGSTAB, kGMRES };
+
+  explicit S21KrylovSolver(const S21LinearOperator &matrix,
+                           const Method method = kGMRES);
+
+  void set_preconditioner(const S21LinearOperator &preconditioner);
+  void set_tolerance(const double tolerance);
+  void set_max_iterations(const int iterations);
+  void set_restart(const int restart);
+  int get_iterations() const noexcept;
+  double get_residual() const noexcept;
+
+  bool Solve(const double *b, double *x);
+  S21Matrix Solve(const S21Matrix &b);
+
+  static constexpr double kDefaultTolerance = 1e-10;
+  static constexpr int kDefaultMaxIterations = 1000;
+  static constexpr int kDefaultRestart = 30;
+
+ private:
+  void Allocate();
+  double *Vector(const int index) noexcept;
+  double Dot(const double *lhs, const double *rhs);
+  double Norm(const double *values);
+  bool SolveCG(const double *b, double *x, const double target);
+  bool SolveBiCGSTAB(const double *b, double *x, const double target);
+  bool SolveGMRES(const double *b, double *x, const double target);
+  S21LinearOperator matrix_;
+  S21LinearOperator preconditioner_;
+  Method method_;
+  double tolerance_{kDefaultTolerance};
+  int max_iterations_{kDefaultMaxIterations};
+  int restart_{kDefaultRestart};
+  int iterations_{0};
+  double residual_{0.0};
+  std::vector<double> workspace_;
+  std::vector<double> hessenberg_;
+  std::vector<double> partials_;
+};
+
+}  // namespace s21
+
+#endif  // CPP1_S21_MATRIXPLUS_4_S21_KRYLOV_H_
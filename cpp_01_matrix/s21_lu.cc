@@ -0,0 +1,259 @@
+#include "s21_lu.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "s21_matrix_stats.h"
+#include "s21_parallel.h"
+
+namespace s21 {
+
+S21LU::S21LU(const S21Matrix& matrix, const int block)
+    : factors_(matrix), size_(matrix.get_rows()) {
+  if (!size_) {
+    throw std::logic_error("LU: operation with NULL matrix");
+  }
+  if (matrix.get_rows() != matrix.get_cols()) {
+    throw std::logic_error("LU: matrix isn't square");
+  }
+  S21_STATS_OPERATION(stats::kLU, 2.0 / 3.0 * size_ * size_ * size_);
+  factors_.set_copy_on_write(false);
+  pivots_.resize(size_);
+  rows_.resize(size_);
+  BindRows();
+  tolerance_ = size_ * std::numeric_limits<double>::epsilon() *
+               std::max(matrix.Max(), -matrix.Min());
+  const int step = std::max(1, block);
+  FactorPanel(0, std::min(step, size_));
+  for (int first = 0; first < size_; first += step) {
+    const int last = std::min(size_, first + step);
+    const int next = std::min(size_, last + step);
+    SwapRows(first, last, 0, first);
+    SwapRows(first, last, last, size_);
+    SolvePanelRows(first, last);
+    if (last == size_) {
+      break;
+    }
+    UpdateTrailing(first, last, last, next);
+    // The next panel and the rest of the trailing matrix share no columns.
+    parallel::For(0, 2, 1, [&](const int task_first, const int task_last) {
+      for (int task = task_first; task < task_last; ++task) {
+        if (task) {
+          UpdateTrailing(first, last, next, size_);
+        } else {
+          FactorPanel(last, next);
+        }
+      }
+    });
+  }
+}
+
+S21LU::S21LU(const S21LU& other)
+    : factors_(other.factors_),
+      pivots_(other.pivots_),
+      rows_(other.size_),
+      size_(other.size_),
+      tolerance_(other.tolerance_),
+      singular_(other.singular_) {
+  BindRows();
+}
+
+S21LU::S21LU(S21LU&& other) noexcept
+    : factors_(std::move(other.factors_)),
+      pivots_(std::move(other.pivots_)),
+      rows_(std::move(other.rows_)),
+      size_(other.size_),
+      tolerance_(other.tolerance_),
+      singular_(other.singular_) {
+  other.size_ = 0;
+  BindRows();
+}
+
+S21LU& S21LU::operator=(const S21LU& other) {
+  if (this != &other) {
+    *this = S21LU(other);
+  }
+  return *this;
+}
+
+S21LU& S21LU::operator=(S21LU&& other) noexcept {
+  if (this != &other) {
+    factors_ = std::move(other.factors_);
+    pivots_ = std::move(other.pivots_);
+    rows_ = std::move(other.rows_);
+    size_ = other.size_;
+    tolerance_ = other.tolerance_;
+    singular_ = other.singular_;
+    other.size_ = 0;
+    BindRows();
+  }
+  return *this;
+}
+
+const S21Matrix& S21LU::get_factors() const noexcept { return factors_; }
+
+const std::vector<int>& S21LU::get_pivots() const noexcept { return pivots_; }
+
+bool S21LU::IsSingular() const noexcept { return singular_; }
+
+double S21LU::Determinant() const noexcept {
+  if (singular_) {
+    return 0.0;
+  }
+  double result = 1.0;
+  for (int i = 0; i < size_; ++i) {
+    result *= pivots_[i] == i ? rows_[i][i] : -rows_[i][i];
+  }
+  return result;
+}
+
+S21Matrix S21LU::Solve(const S21Matrix& rhs) const {
+  if (rhs.get_rows() != size_) {
+    throw std::logic_error("LU: rhs(rows) != matrix(rows)");
+  }
+  if (singular_) {
+    throw std::logic_error("Determinant is zero");
+  }
+  S21Matrix result{rhs};
+  const int cols = result.get_cols();
+  std::vector<double*> out(size_);
+  for (int i = 0; i < size_; ++i) {
+    out[i] = result[i];
+  }
+  for (int i = 0; i < size_; ++i) {
+    if (pivots_[i] != i) {
+      std::swap_ranges(out[i], out[i] + cols, out[pivots_[i]]);
+    }
+  }
+  for (int i = 0; i < size_; ++i) {
+    for (int k = 0; k < i; ++k) {
+      const double factor = rows_[i][k];
+      for (int j = 0; j < cols; ++j) {
+        out[i][j] -= factor * out[k][j];
+      }
+    }
+  }
+  for (int i = size_ - 1; i >= 0; --i) {
+    for (int k = i + 1; k < size_; ++k) {
+      const double factor = rows_[i][k];
+      for (int j = 0; j < cols; ++j) {
+        out[i][j] -= factor * out[k][j];
+      }
+    }
+    for (int j = 0; j < cols; ++j) {
+      out[i][j] /= rows_[i][i];
+    }
+  }
+  return result;
+}
+
+S21Matrix S21LU::Inverse() const {
+  S21Matrix identity(size_);
+  for (int i = 0; i < size_; ++i) {
+    identity[i][i] = 1.0;
+  }
+  return Solve(identity);
+}
+
+// rows_ points into factors_, so it is rebuilt whenever factors_ moves,
+// including the inline storage of small matrices.
+void S21LU::BindRows() noexcept {
+  const S21Matrix& factors = factors_;
+  for (int i = 0; i < size_; ++i) {
+    rows_[i] = const_cast<double*>(factors[i]);
+  }
+}
+
+// Unblocked factorization of columns [first, last), row swaps are applied
+// inside the panel only, the rest of the rows is swapped by SwapRows.
+void S21LU::FactorPanel(const int first, const int last) noexcept {
+  for (int j = first; j < last; ++j) {
+    int pivot = j;
+    for (int i = j + 1; i < size_; ++i) {
+      if (fabs(rows_[i][j]) > fabs(rows_[pivot][j])) {
+        pivot = i;
+      }
+    }
+    pivots_[j] = pivot;
+    if (pivot != j) {
+      std::swap_ranges(rows_[j] + first, rows_[j] + last,
+                       rows_[pivot] + first);
+    }
+    if (fabs(rows_[j][j]) <= tolerance_) {
+      singular_ = true;
+      continue;
+    }
+    const double* pivot_row = rows_[j];
+    for (int i = j + 1; i < size_; ++i) {
+      double* row = rows_[i];
+      row[j] /= pivot_row[j];
+      const double factor = row[j];
+      for (int k = j + 1; k < last; ++k) {
+        row[k] -= factor * pivot_row[k];
+      }
+    }
+  }
+}
+
+void S21LU::SwapRows(const int first, const int last, const int col_first,
+                     const int col_last) noexcept {
+  if (col_first >= col_last) {
+    return;
+  }
+  for (int j = first; j < last; ++j) {
+    if (pivots_[j] != j) {
+      std::swap_ranges(rows_[j] + col_first, rows_[j] + col_last,
+                       rows_[pivots_[j]] + col_first);
+    }
+  }
+}
+
+// U12 = L11^-1 * A12 for the rows of the panel [first, last).
+void S21LU::SolvePanelRows(const int first, const int last) {
+  const int grain = std::max(1, (1 << 14) / ((last - first) * (last - first)));
+  parallel::For(last, size_, grain, [&](const int col_first,
+                                        const int col_last) {
+    for (int i = first + 1; i < last; ++i) {
+      double* row = rows_[i];
+      for (int k = first; k < i; ++k) {
+        const double factor = row[k];
+        const double* upper = rows_[k];
+        for (int j = col_first; j < col_last; ++j) {
+          row[j] -= factor * upper[j];
+        }
+      }
+    }
+  });
+}
+
+// A22 -= L21 * U12 restricted to columns [col_first, col_last).
+void S21LU::UpdateTrailing(const int first, const int last,
+                           const int col_first, const int col_last) {
+  const int kBlockCols = 512;
+  if (col_first >= col_last) {
+    return;
+  }
+  const long work = static_cast<long>(last - first) * (col_last - col_first);
+  const int grain = static_cast<int>(std::max(1L, (1L << 16) / (work + 1)));
+  parallel::For(last, size_, grain, [&](const int row_first,
+                                        const int row_last) {
+    for (int j0 = col_first; j0 < col_last; j0 += kBlockCols) {
+      const int j1 = std::min(col_last, j0 + kBlockCols);
+      for (int i = row_first; i < row_last; ++i) {
+        double* row = rows_[i];
+        for (int k = first; k < last; ++k) {
+          const double factor = row[k];
+          const double* upper = rows_[k];
+          for (int j = j0; j < j1; ++j) {
+            row[j] -= factor * upper[j];
+          }
+        }
+      }
+    }
+  });
+}
+
+}  // namespace s21
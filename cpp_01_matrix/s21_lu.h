@@ -0,0 +1,48 @@
+#ifndef CPP1_S21_MATRIXPLUS_4_S21_LU_H_
+#define CPP1_S21_MATRIXPLUS_4_S21_LU_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+namespace s21 {
+
+// Right-looking blocked LU factorization with partial pivoting, PA = LU.
+// The trailing update of every step is split between threads while the next
+// panel is factorized concurrently (look-ahead of depth one). Pivots up to
+// n * eps * max|A| in magnitude count as zero.
+class S21LU {
+ public:
+  explicit S21LU(const S21Matrix &matrix, const int block = kDefaultBlock);
+  S21LU(const S21LU &other);
+  S21LU(S21LU &&other) noexcept;
+  S21LU &operator=(const S21LU &other);
+  S21LU &operator=(S21LU &&other) noexcept;
+  const S21Matrix &get_factors() const noexcept;
+  const std::vector<int> &get_pivots() const noexcept;
+  bool IsSingular() const noexcept;
+  double Determinant() const noexcept;
+  S21Matrix Solve(const S21Matrix &rhs) const;
+  S21Matrix Inverse() const;
+
+  static constexpr int kDefaultBlock = 64;
+
+ private:
+  void BindRows() noexcept;
+  void FactorPanel(const int first, const int last) noexcept;
+  void SwapRows(const int first, const int last, const int col_first,
+                const int col_last) noexcept;
+  void SolvePanelRows(const int first, const int last);
+  void UpdateTrailing(const int first, const int last, const int col_first,
+                      const int col_last);
+  S21Matrix factors_;
+  std::vector<int> pivots_;
+  std::vector<double *> rows_;
+  int size_{0};
+  double tolerance_{0.0};
+  bool singular_{false};
+};
+
+}  // namespace s21
+
+#endif  // CPP1_S21_MATRIXPLUS_4_S21_LU_H_
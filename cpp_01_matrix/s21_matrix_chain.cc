@@ -0,0 +1,157 @@
+#include "s21_matrix_chain.h"
+
+#include <limits>
+#include <stdexcept>
+
+#include "s21_parallel.h"
+
+namespace s21 {
+
+S21MatrixChain::S21MatrixChain(
+    std::initializer_list<std::reference_wrapper<const S21Matrix>> matrices) {
+  for (const S21Matrix& matrix : matrices) {
+    *this *= matrix;
+  }
+}
+
+S21MatrixChain& S21MatrixChain::operator*=(const S21Matrix& matrix) {
+  if (!matrices_.empty() &&
+      matrices_.back()->get_cols() != matrix.get_rows()) {
+    throw std::logic_error("MatrixChain: M1(cols) != M2(rows)");
+  }
+  matrices_.push_back(&matrix);
+  return *this;
+}
+
+int S21MatrixChain::get_size() const noexcept {
+  return static_cast<int>(matrices_.size());
+}
+
+double S21MatrixChain::Cost() const {
+  CheckNotEmpty();
+  std::vector<double> cost;
+  Plan(&cost);
+  return cost[get_size() - 1];
+}
+
+std::string S21MatrixChain::Order() const {
+  CheckNotEmpty();
+  return Order(Plan(nullptr), 0, get_size() - 1);
+}
+
+S21Matrix S21MatrixChain::Evaluate() const {
+  CheckNotEmpty();
+  if (get_size() == 1) {
+    return *matrices_[0];
+  }
+  Workspaces workspaces;
+  return Evaluate(Plan(nullptr), 0, get_size() - 1, workspaces);
+}
+
+S21Matrix S21MatrixChain::Workspaces::Take(const int rows, const int cols) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto it = free_.begin(); it != free_.end(); ++it) {
+    if (it->get_rows() == rows && it->get_cols() == cols) {
+      S21Matrix result{std::move(*it)};
+      free_.erase(it);
+      return result;
+    }
+  }
+  return S21Matrix();
+}
+
+void S21MatrixChain::Workspaces::Give(S21Matrix&& matrix) {
+  if (matrix.get_rows()) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_.push_back(std::move(matrix));
+  }
+}
+
+// split[first * size + last] is the index k of the best split
+// (first..k)(k+1..last); cost, when requested, receives the cost of every
+// prefix chain 0..last.
+std::vector<int> S21MatrixChain::Plan(std::vector<double>* cost) const {
+  const int size = get_size();
+  std::vector<double> dims(size + 1);
+  for (int i = 0; i < size; ++i) {
+    dims[i] = matrices_[i]->get_rows();
+  }
+  dims[size] = matrices_.back()->get_cols();
+  std::vector<double> best(static_cast<size_t>(size) * size, 0.0);
+  std::vector<int> split(static_cast<size_t>(size) * size, 0);
+  for (int length = 2; length <= size; ++length) {
+    for (int first = 0; first + length <= size; ++first) {
+      const int last = first + length - 1;
+      double& current = best[first * size + last];
+      current = std::numeric_limits<double>::infinity();
+      for (int k = first; k < last; ++k) {
+        const double value = best[first * size + k] +
+                             best[(k + 1) * size + last] +
+                             dims[first] * dims[k + 1] * dims[last + 1];
+        if (value < current) {
+          current = value;
+          split[first * size + last] = k;
+        }
+      }
+    }
+  }
+  if (cost) {
+    cost->resize(size);
+    for (int last = 0; last < size; ++last) {
+      (*cost)[last] = best[last];
+    }
+  }
+  return split;
+}
+
+std::string S21MatrixChain::Order(const std::vector<int>& split,
+                                  const int first, const int last) const {
+  if (first == last) {
+    return "A" + std::to_string(first + 1);
+  }
+  const int k = split[first * get_size() + last];
+  return "(" + Order(split, first, k) + "*" + Order(split, k + 1, last) + ")";
+}
+
+S21Matrix S21MatrixChain::Evaluate(const std::vector<int>& split,
+                                   const int first, const int last,
+                                   Workspaces& workspaces) const {
+  const int k = split[first * get_size() + last];
+  const bool left_product = k > first;
+  const bool right_product = k + 1 < last;
+  S21Matrix left;
+  S21Matrix right;
+  if (left_product && right_product) {
+    parallel::For(0, 2, 1, [&](const int task_first, const int task_last) {
+      for (int task = task_first; task < task_last; ++task) {
+        if (task) {
+          right = Evaluate(split, k + 1, last, workspaces);
+        } else {
+          left = Evaluate(split, first, k, workspaces);
+        }
+      }
+    });
+  } else {
+    if (left_product) {
+      left = Evaluate(split, first, k, workspaces);
+    }
+    if (right_product) {
+      right = Evaluate(split, k + 1, last, workspaces);
+    }
+  }
+  const S21Matrix& lhs = left_product ? left : *matrices_[first];
+  const S21Matrix& rhs = right_product ? right : *matrices_[last];
+  S21Matrix result = workspaces.Take(lhs.get_rows(), rhs.get_cols());
+  result.Product(lhs, rhs);
+  workspaces.Give(std::move(left));
+  workspaces.Give(std::move(right));
+  return result;
+}
+
+void S21MatrixChain::CheckNotEmpty() const {
+  if (matrices_.empty()) {
+    throw std::logic_error("MatrixChain: empty chain");
+  }
+}
+
+}  // namespace s21
@@ -0,0 +1,53 @@
+#ifndef CPP1_S21_MATRIXPLUS_4_S21_MATRIX_CHAIN_H_
+#define CPP1_S21_MATRIXPLUS_4_S21_MATRIX_CHAIN_H_
+
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+namespace s21 {
+
+// Product of a chain of matrices evaluated in the order with the fewest
+// scalar multiplications (classic O(n^3) dynamic programming over shapes).
+// Independent sub-products share the parallel::For pool and intermediate
+// buffers are recycled once consumed. Operands are held by reference, so
+// temporaries are rejected.
+class S21MatrixChain {
+ public:
+  S21MatrixChain() = default;
+  S21MatrixChain(
+      std::initializer_list<std::reference_wrapper<const S21Matrix>> matrices);
+  S21MatrixChain &operator*=(const S21Matrix &matrix);
+  S21MatrixChain &operator*=(S21Matrix &&matrix) = delete;
+  int get_size() const noexcept;
+  double Cost() const;
+  std::string Order() const;
+  S21Matrix Evaluate() const;
+
+ private:
+  class Workspaces {
+   public:
+    S21Matrix Take(const int rows, const int cols);
+    void Give(S21Matrix &&matrix);
+
+   private:
+    std::mutex mutex_;
+    std::vector<S21Matrix> free_;
+  };
+
+  std::vector<int> Plan(std::vector<double> *cost) const;
+  std::string Order(const std::vector<int> &split, const int first,
+                    const int last) const;
+  S21Matrix Evaluate(const std::vector<int> &split, const int first,
+                     const int last, Workspaces &workspaces) const;
+  void CheckNotEmpty() const;
+  std::vector<const S21Matrix *> matrices_;
+};
+
+}  // namespace s21
+
+#endif  // CPP1_S21_MATRIXPLUS_4_S21_MATRIX_CHAIN_H_
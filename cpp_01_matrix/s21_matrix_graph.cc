@@ -0,0 +1,270 @@
+#include "s21_matrix_graph.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "s21_parallel.h"
+
+namespace s21 {
+
+bool S21MatrixGraph::Handle::IsReady() const noexcept {
+  return state_ && state_->done;
+}
+
+const S21Matrix& S21MatrixGraph::Handle::Get() const {
+  if (!graph_) {
+    throw std::logic_error("MatrixGraph: empty handle");
+  }
+  std::lock_guard<std::mutex> lock(graph_->mutex_);
+  const Node& node = graph_->Find(*this);
+  if (!node.done) {
+    graph_->RunPending();
+  }
+  if (node.released) {
+    throw std::logic_error("MatrixGraph: result was released");
+  }
+  return node.source ? *node.source : node.result;
+}
+
+int S21MatrixGraph::get_size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return static_cast<int>(nodes_.size());
+}
+
+S21MatrixGraph::Handle S21MatrixGraph::Input(const S21Matrix& matrix) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Node& node = nodes_.emplace_back();
+  node.source = &matrix;
+  node.done = true;
+  return Add(node);
+}
+
+S21MatrixGraph::Handle S21MatrixGraph::Schedule(
+    const std::vector<Handle>& inputs, Operation operation) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const Handle& input : inputs) {
+    if (Find(input).released) {
+      throw std::logic_error("MatrixGraph: result was released");
+    }
+  }
+  const int index = static_cast<int>(nodes_.size());
+  Node& node = nodes_.emplace_back();
+  node.operation = std::move(operation);
+  for (const Handle& input : inputs) {
+    node.inputs.push_back(input.node_);
+    nodes_[input.node_].consumers.push_back(index);
+  }
+  return Add(node);
+}
+
+S21MatrixGraph::Handle S21MatrixGraph::Sum(const Handle& lhs,
+                                           const Handle& rhs) {
+  return Schedule({lhs, rhs}, [](const std::vector<const S21Matrix*>& args) {
+    return *args[0] + *args[1];
+  });
+}
+
+S21MatrixGraph::Handle S21MatrixGraph::Sub(const Handle& lhs,
+                                           const Handle& rhs) {
+  return Schedule({lhs, rhs}, [](const std::vector<const S21Matrix*>& args) {
+    return *args[0] - *args[1];
+  });
+}
+
+S21MatrixGraph::Handle S21MatrixGraph::Mul(const Handle& lhs,
+                                           const Handle& rhs) {
+  return Schedule({lhs, rhs}, [](const std::vector<const S21Matrix*>& args) {
+    return *args[0] * *args[1];
+  });
+}
+
+S21MatrixGraph::Handle S21MatrixGraph::MulNumber(const Handle& matrix,
+                                                 const double num) {
+  return Schedule({matrix}, [num](const std::vector<const S21Matrix*>& args) {
+    return *args[0] * num;
+  });
+}
+
+S21MatrixGraph::Handle S21MatrixGraph::Transpose(const Handle& matrix) {
+  return Schedule({matrix}, [](const std::vector<const S21Matrix*>& args) {
+    return args[0]->Transpose();
+  });
+}
+
+S21MatrixGraph::Handle S21MatrixGraph::Inverse(const Handle& matrix) {
+  return Schedule({matrix}, [](const std::vector<const S21Matrix*>& args) {
+    return args[0]->InverseMatrix();
+  });
+}
+
+void S21MatrixGraph::Keep(const Handle& handle) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Find(handle).keep = true;
+}
+
+void S21MatrixGraph::Run() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  RunPending();
+}
+
+// The node was just appended to nodes_.
+S21MatrixGraph::Handle S21MatrixGraph::Add(Node& node) {
+  return Handle(this, static_cast<int>(nodes_.size()) - 1, &node);
+}
+
+// Executes every node that has not run yet, called with mutex_ held. Nodes
+// computed by an earlier run count as finished dependencies and are never
+// released afterwards, their consumer counts may be stale after a failure.
+void S21MatrixGraph::RunPending() {
+  std::vector<int> ready;
+  int count = 0;
+  for (int i = 0; i < static_cast<int>(nodes_.size()); ++i) {
+    Node& node = nodes_[i];
+    if (node.done) {
+      node.releasable = false;
+      continue;
+    }
+    ++count;
+    node.pending = static_cast<int>(
+        std::count_if(node.inputs.begin(), node.inputs.end(),
+                      [this](const int input) { return !nodes_[input].done; }));
+    node.users = static_cast<int>(node.consumers.size());
+    node.releasable = !node.keep && !node.consumers.empty();
+    if (!node.pending) {
+      ready.push_back(i);
+    }
+  }
+  if (!count) {
+    return;
+  }
+  const int workers = std::min(parallel::ThreadCount(), count);
+  Scheduler scheduler(*this, workers, count);
+  for (size_t i = 0; i < ready.size(); ++i) {
+    scheduler.Push(static_cast<int>(i % workers), ready[i]);
+  }
+  parallel::For(0, workers, 1, [&scheduler](const int first, const int last) {
+    for (int worker = first; worker < last; ++worker) {
+      scheduler.Work(worker);
+    }
+  });
+  scheduler.Rethrow();
+}
+
+// Called with mutex_ held.
+S21MatrixGraph::Node& S21MatrixGraph::Find(const Handle& handle) {
+  if (handle.graph_ != this || handle.node_ < 0 ||
+      handle.node_ >= static_cast<int>(nodes_.size())) {
+    throw std::logic_error("MatrixGraph: handle from another graph");
+  }
+  return nodes_[handle.node_];
+}
+
+S21MatrixGraph::Scheduler::Scheduler(S21MatrixGraph& graph, const int workers,
+                                     const int nodes)
+    : graph_(graph), queues_(workers), remaining_(nodes) {}
+
+// Counting queued nodes under mutex_ means a worker that found every queue
+// empty cannot miss the wakeup for a node pushed right after.
+void S21MatrixGraph::Scheduler::Push(const int worker, const int node) {
+  {
+    std::lock_guard<std::mutex> lock(queues_[worker].mutex);
+    queues_[worker].nodes.push_back(node);
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++queued_;
+  }
+  wakeup_.notify_one();
+}
+
+void S21MatrixGraph::Scheduler::Work(const int worker) {
+  while (true) {
+    int node = 0;
+    if (Pop(worker, &node)) {
+      Execute(worker, node);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    wakeup_.wait(lock,
+                 [this] { return queued_ > 0 || !remaining_ || failed_; });
+    if (!remaining_ || failed_) {
+      return;
+    }
+  }
+}
+
+void S21MatrixGraph::Scheduler::Rethrow() const {
+  if (error_) {
+    std::rethrow_exception(error_);
+  }
+}
+
+bool S21MatrixGraph::Scheduler::Pop(const int worker, int* node) {
+  const int workers = static_cast<int>(queues_.size());
+  for (int i = 0; i < workers; ++i) {
+    Queue& queue = queues_[(worker + i) % workers];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.nodes.empty()) {
+      continue;
+    }
+    if (i) {
+      *node = queue.nodes.front();
+      queue.nodes.pop_front();
+    } else {
+      *node = queue.nodes.back();
+      queue.nodes.pop_back();
+    }
+    --queued_;
+    return true;
+  }
+  return false;
+}
+
+// Consumers made ready by this node go to the worker's own queue, so a chain
+// of operations tends to stay on one thread while its inputs are still hot.
+void S21MatrixGraph::Scheduler::Execute(const int worker, const int index) {
+  Node& node = graph_.nodes_[index];
+  std::vector<const S21Matrix*> arguments;
+  arguments.reserve(node.inputs.size());
+  for (int input : node.inputs) {
+    const Node& source = graph_.nodes_[input];
+    arguments.push_back(source.source ? source.source : &source.result);
+  }
+  try {
+    node.result = node.operation(arguments);
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!error_) {
+      error_ = std::current_exception();
+    }
+    Finish(true);
+    return;
+  }
+  node.done = true;
+  for (int input : node.inputs) {
+    Node& source = graph_.nodes_[input];
+    if (source.users.fetch_sub(1) == 1 && source.releasable) {
+      source.result = S21Matrix();
+      source.released = true;
+    }
+  }
+  for (int consumer : node.consumers) {
+    if (graph_.nodes_[consumer].pending.fetch_sub(1) == 1) {
+      Push(worker, consumer);
+    }
+  }
+  if (remaining_.fetch_sub(1) == 1) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Finish(false);
+  }
+}
+
+// Called with mutex_ held.
+void S21MatrixGraph::Scheduler::Finish(const bool failed) {
+  if (failed) {
+    failed_ = true;
+  }
+  wakeup_.notify_all();
+}
+
+}  // namespace s21
@@ -0,0 +1,115 @@
+#ifndef CPP1_S21_MATRIXPLUS_4_S21_MATRIX_GRAPH_H_
+#define CPP1_S21_MATRIXPLUS_4_S21_MATRIX_GRAPH_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+namespace s21 {
+
+// Deferred S21Matrix operations recorded as a DAG. Every operation returns a
+// handle right away, Run() executes the pending nodes with work-stealing
+// queues for up to parallel::ThreadCount() workers of the parallel::For pool,
+// so independent nodes run concurrently. An intermediate result is released
+// as soon as its last consumer finishes unless it was passed to Keep();
+// results nobody consumes are always kept. Inputs are held by reference.
+// Members may be called from any thread: one Run() executes at a time and
+// Get() of a pending node waits for it. Operations must not use their graph.
+class S21MatrixGraph {
+  struct Node;
+
+ public:
+  using Operation =
+      std::function<S21Matrix(const std::vector<const S21Matrix *> &)>;
+
+  class Handle {
+    friend class S21MatrixGraph;
+
+   public:
+    Handle() = default;
+    bool IsReady() const noexcept;
+    const S21Matrix &Get() const;
+
+   private:
+    Handle(S21MatrixGraph *graph, const int node, const Node *state) noexcept
+        : graph_(graph), node_(node), state_(state) {}
+    S21MatrixGraph *graph_{nullptr};
+    int node_{-1};
+    const Node *state_{nullptr};
+  };
+
+  S21MatrixGraph() = default;
+  S21MatrixGraph(const S21MatrixGraph &other) = delete;
+  void operator=(const S21MatrixGraph &other) = delete;
+  int get_size() const;
+  Handle Input(const S21Matrix &matrix);
+  Handle Schedule(const std::vector<Handle> &inputs, Operation operation);
+  Handle Sum(const Handle &lhs, const Handle &rhs);
+  Handle Sub(const Handle &lhs, const Handle &rhs);
+  Handle Mul(const Handle &lhs, const Handle &rhs);
+  Handle MulNumber(const Handle &matrix, const double num);
+  Handle Transpose(const Handle &matrix);
+  Handle Inverse(const Handle &matrix);
+  void Keep(const Handle &handle);
+  void Run();
+
+ private:
+  struct Node {
+    Operation operation;
+    std::vector<int> inputs;
+    std::vector<int> consumers;
+    const S21Matrix *source{nullptr};
+    S21Matrix result;
+    std::atomic<int> pending{0};
+    std::atomic<int> users{0};
+    bool keep{false};
+    bool releasable{false};
+    std::atomic<bool> done{false};
+    std::atomic<bool> released{false};
+  };
+
+  // Ready nodes of one worker, the owner takes the newest node and thieves
+  // take the oldest one.
+  struct Queue {
+    std::mutex mutex;
+    std::deque<int> nodes;
+  };
+
+  class Scheduler {
+   public:
+    Scheduler(S21MatrixGraph &graph, const int workers, const int nodes);
+    void Push(const int worker, const int node);
+    void Work(const int worker);
+    void Rethrow() const;
+
+   private:
+    bool Pop(const int worker, int *node);
+    void Execute(const int worker, const int node);
+    void Finish(const bool failed);
+    S21MatrixGraph &graph_;
+    std::vector<Queue> queues_;
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    std::atomic<int> queued_{0};
+    std::atomic<int> remaining_;
+    std::atomic<bool> failed_{false};
+    std::exception_ptr error_;
+  };
+
+  Handle Add(Node &node);
+  void RunPending();
+  Node &Find(const Handle &handle);
+  mutable std::mutex mutex_;
+  // A deque keeps nodes in place, so handles can point at them.
+  std::deque<Node> nodes_;
+};
+
+}  // namespace s21
+
+#endif  // CPP1_S21_MATRIXPLUS_4_S21_MATRIX_GRAPH_H_
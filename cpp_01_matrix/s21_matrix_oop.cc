@@ -2,10 +2,112 @@
 
 #include <math.h>
 
+#include <algorithm>
 #include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "s21_lu.h"
+#include "s21_matrix_stats.h"
+#include "s21_numa.h"
+#include "s21_parallel.h"
+#include "s21_random.h"
+#include "s21_simd.h"
+#include "s21_small_matrix.h"
 
 namespace s21 {
 
+namespace {
+
+template <int N>
+void StoreSquare(const small::Square<N>& square, double* out) noexcept {
+  std::copy(square.begin(), square.end(), out);
+}
+
+// Elements 2k and 2k + 1 come from Philox block k: two uniform values built
+// from words 0, 1 and 2, 3, or the Box-Muller pair of those values. Two
+// blocks are generated at once in vector lanes.
+void RandomRange(double* values, const size_t begin, const size_t end,
+                 const uint64_t seed, const bool normal, const double location,
+                 const double scale) noexcept {
+  constexpr double kTwoPi = 6.283185307179586;
+  for (uint64_t block = begin / 2; block * 2 < end; block += 2) {
+    const auto blocks = random::Generate(simd::Uint2{block, block + 1}, seed);
+    const simd::Uint2* words = blocks.words;
+    const simd::Double2 first =
+        __builtin_convertvector(random::Mantissa(words[0], words[1]),
+                                simd::Double2) *
+        random::kMantissaScale;
+    const simd::Double2 second =
+        __builtin_convertvector(random::Mantissa(words[2], words[3]),
+                                simd::Double2) *
+        random::kMantissaScale;
+    double pairs[4] = {first[0], second[0], first[1], second[1]};
+    if (normal) {
+      for (int j = 0; j < 4; j += 2) {
+        const double radius = sqrt(-2.0 * log(1.0 - pairs[j]));
+        const double angle = kTwoPi * pairs[j + 1];
+        pairs[j] = radius * cos(angle);
+        pairs[j + 1] = radius * sin(angle);
+      }
+    }
+    const size_t offset = block * 2;
+    for (size_t i = std::max(begin, offset); i < std::min(end, offset + 4);
+         ++i) {
+      values[i] = location + scale * pairs[i - offset];
+    }
+  }
+}
+
+double SmallDeterminant(const double* data, const int size) noexcept {
+  switch (size) {
+    case 2:
+      return small::Determinant<2>(small::Load<2>(data));
+    case 3:
+      return small::Determinant<3>(small::Load<3>(data));
+    case 4:
+      return small::Determinant<4>(small::Load<4>(data));
+  }
+  return data[0];
+}
+
+void SmallComplements(const double* data, const int size, double* out) {
+  switch (size) {
+    case 2:
+      return StoreSquare<2>(small::Complements<2>(small::Load<2>(data)), out);
+    case 3:
+      return StoreSquare<3>(small::Complements<3>(small::Load<3>(data)), out);
+    case 4:
+      return StoreSquare<4>(small::Complements<4>(small::Load<4>(data)), out);
+  }
+}
+
+void SmallInverse(const double* data, const int size, double* out) {
+  switch (size) {
+    case 2:
+      return StoreSquare<2>(small::Inverse<2>(small::Load<2>(data)), out);
+    case 3:
+      return StoreSquare<3>(small::Inverse<3>(small::Load<3>(data)), out);
+    case 4:
+      return StoreSquare<4>(small::Inverse<4>(small::Load<4>(data)), out);
+  }
+}
+
+// Largest of non-negative sums, NaN if any sum is NaN.
+double MaxSum(const std::vector<double>& sums) {
+  double result = 0.0;
+  for (const double sum : sums) {
+    if (isnan(sum)) {
+      return sum;
+    }
+    result = std::max(result, sum);
+  }
+  return result;
+}
+
+}  // namespace
+
 S21Matrix::S21Matrix(int size) : S21Matrix(size, size) {}
 
 S21Matrix::S21Matrix(int rows, int cols) { CreateObject(rows, cols); }
@@ -35,6 +137,7 @@ double S21Matrix::operator()(const int row, const int col) const {
 }
 
 double& S21Matrix::operator()(const int row, const int col) {
+  DetachMatrix();
   return FindElement(row, col);
 }
 
@@ -52,21 +155,120 @@ void S21Matrix::set_cols(const int cols) {
   set_size(rows_, cols);
 }
 
+// Resizes in place while the new shape fits the reserved capacity, growing
+// the capacity geometrically otherwise, so appending rows one by one is
+// amortized linear. Empty and shared matrices get a fresh exact buffer.
 void S21Matrix::set_size(const int rows, const int cols) {
   if (rows < 0 || cols < 0) {
     throw std::logic_error("setter: rows or cols less than zero");
   }
+  const size_t size = static_cast<size_t>(rows) * cols;
+  if (size && matrix_ && !IsShared()) {
+    if (size > capacity_ || rows > row_capacity_) {
+      ReserveMatrix(std::max(size, 2 * capacity_),
+                    std::max(rows, 2 * row_capacity_));
+    }
+    ResizeMatrix(rows, cols);
+    return;
+  }
   S21Matrix temp{std::move(*this)};
+  copy_on_write_ = temp.copy_on_write_;
   CreateObject(rows, cols);
   temp.rows_ = std::min(rows_, temp.rows_);
   temp.cols_ = std::min(cols_, temp.cols_);
   CopyMatrix(temp);
 }
 
+size_t S21Matrix::get_capacity() const noexcept { return capacity_; }
+
+// Makes room for a rows x cols shape without changing the current one. An
+// empty matrix has no buffer yet, so the call does nothing for it.
+void S21Matrix::Reserve(const int rows, const int cols) {
+  if (rows < 0 || cols < 0) {
+    throw std::logic_error("Reserve: rows or cols less than zero");
+  }
+  const size_t size = static_cast<size_t>(rows) * cols;
+  if (!matrix_ || (size <= capacity_ && rows <= row_capacity_)) {
+    return;
+  }
+  DetachMatrix();
+  ReserveMatrix(std::max(size, capacity_), std::max(rows, row_capacity_));
+}
+
+bool S21Matrix::get_copy_on_write() const noexcept { return copy_on_write_; }
+
+void S21Matrix::set_copy_on_write(const bool enabled) {
+  if (!enabled) {
+    DetachMatrix();
+    delete references_;
+    references_ = nullptr;
+  } else if (matrix_ && !references_ && !IsInline()) {
+    references_ = new std::atomic<long>{1};
+  }
+  copy_on_write_ = enabled;
+}
+
+bool S21Matrix::IsShared() const noexcept {
+  return references_ && references_->load() > 1;
+}
+
+double* S21Matrix::operator[](const int row) {
+  DetachMatrix();
+  return matrix_[row];
+}
+
+const double* S21Matrix::operator[](const int row) const noexcept {
+  return matrix_[row];
+}
+
+double* S21Matrix::data() {
+  DetachMatrix();
+  return matrix_ ? matrix_[0] : nullptr;
+}
+
+const double* S21Matrix::data() const noexcept {
+  return matrix_ ? matrix_[0] : nullptr;
+}
+
+S21Matrix::iterator S21Matrix::begin() { return data(); }
+
+S21Matrix::iterator S21Matrix::end() { return data() + GetSize(); }
+
+S21Matrix::const_iterator S21Matrix::begin() const noexcept { return data(); }
+
+S21Matrix::const_iterator S21Matrix::end() const noexcept {
+  return data() + GetSize();
+}
+
+S21Matrix::const_iterator S21Matrix::cbegin() const noexcept {
+  return begin();
+}
+
+S21Matrix::const_iterator S21Matrix::cend() const noexcept { return end(); }
+
+S21Matrix::RowSpan<double> S21Matrix::Row(const int row) {
+  return {(*this)[row], cols_};
+}
+
+S21Matrix::RowSpan<const double> S21Matrix::Row(const int row) const noexcept {
+  return {(*this)[row], cols_};
+}
+
+S21Matrix::RowRange<double> S21Matrix::Rows() {
+  return {data(), rows_, cols_};
+}
+
+S21Matrix::RowRange<const double> S21Matrix::Rows() const noexcept {
+  return {data(), rows_, cols_};
+}
+
 bool S21Matrix::EqMatrix(const S21Matrix& other) const noexcept {
   if (!EqualSize(other)) {
     return false;
   }
+  if (matrix_ == other.matrix_) {
+    return true;
+  }
   for (int i = 0; i < rows_; ++i) {
     if (memcmp(matrix_[i], other.matrix_[i], cols_ * sizeof(double))) {
       return false;
@@ -79,16 +281,156 @@ bool S21Matrix::operator==(const S21Matrix& other) const noexcept {
   return EqMatrix(other);
 }
 
+bool S21Matrix::ApproxEqual(const S21Matrix& other, const double abs_tol,
+                            const double rel_tol) const {
+  const size_t kParallelSize = 1 << 20;
+  const int kChunk = 1 << 16;
+  if (!EqualSize(other)) {
+    return false;
+  }
+  if (GetSize() < kParallelSize) {
+    return ApproxEqualRange(data(), other.data(), GetSize(), abs_tol, rel_tol);
+  }
+  const int chunks = static_cast<int>((GetSize() + kChunk - 1) / kChunk);
+  std::atomic<bool> equal{true};
+  parallel::For(0, chunks, 1, [&](const int first, const int last) {
+    for (int chunk = first; chunk < last && equal.load(); ++chunk) {
+      const size_t offset = static_cast<size_t>(chunk) * kChunk;
+      const size_t size = std::min<size_t>(kChunk, GetSize() - offset);
+      if (!ApproxEqualRange(data() + offset, other.data() + offset, size,
+                            abs_tol, rel_tol)) {
+        equal.store(false);
+      }
+    }
+  });
+  return equal.load();
+}
+
+double S21Matrix::Trace() const {
+  CheckNullAndSquare();
+  double sum = 0.0;
+  double compensation = 0.0;
+  for (int i = 0; i < rows_; ++i) {
+    const double value = matrix_[i][i] - compensation;
+    const double total = sum + value;
+    compensation = (total - sum) - value;
+    sum = total;
+  }
+  return sum;
+}
+
+double S21Matrix::Sum() const {
+  const double* values = data();
+  return ChunkedSum(GetSize(), [values](auto lanes, const size_t i) {
+    return simd::LoadAs<decltype(lanes)>(values + i);
+  });
+}
+
+double S21Matrix::Dot(const S21Matrix& other) const {
+  if (!EqualSize(other)) {
+    throw std::logic_error("Dot: diffrent size");
+  }
+  const double* lhs = data();
+  const double* rhs = other.data();
+  return ChunkedSum(GetSize(), [lhs, rhs](auto lanes, const size_t i) {
+    return simd::LoadAs<decltype(lanes)>(lhs + i) *
+           simd::LoadAs<decltype(lanes)>(rhs + i);
+  });
+}
+
+// Sum of squares in one pass, the rescaled pass is only needed when it
+// overflows or underflows.
+double S21Matrix::NormFrobenius() const {
+  const double kSmall = 1e-280;
+  const double* values = data();
+  const double squares = ChunkedSum(GetSize(), [values](auto lanes,
+                                                        const size_t i) {
+    const auto value = simd::LoadAs<decltype(lanes)>(values + i);
+    return value * value;
+  });
+  if (isnan(squares) ||
+      (squares > kSmall && squares <= std::numeric_limits<double>::max())) {
+    return sqrt(squares);
+  }
+  double scale = 0.0;
+  for (size_t i = 0; i < GetSize(); ++i) {
+    scale = std::max(scale, fabs(values[i]));
+  }
+  if (!scale || scale > std::numeric_limits<double>::max()) {
+    return scale;
+  }
+  const double inverse = 1.0 / scale;
+  const double scaled = ChunkedSum(GetSize(), [values, inverse](
+                                                  auto lanes, const size_t i) {
+    const auto value = simd::LoadAs<decltype(lanes)>(values + i) * inverse;
+    return value * value;
+  });
+  return scale * sqrt(scaled);
+}
+
+double S21Matrix::Norm1() const {
+  std::vector<double> sums(cols_);
+  ColumnSums(sums.data(), true);
+  return MaxSum(sums);
+}
+
+double S21Matrix::NormInf() const {
+  std::vector<double> sums(rows_);
+  const int grain = std::max(1, (1 << 14) / (cols_ + 1));
+  parallel::For(0, rows_, grain, [&](const int first, const int last) {
+    for (int i = first; i < last; ++i) {
+      const double* row = matrix_[i];
+      sums[i] = PairwiseSum(0, cols_, [row](auto lanes, const size_t j) {
+        return simd::Abs(simd::LoadAs<decltype(lanes)>(row + j));
+      });
+    }
+  });
+  return MaxSum(sums);
+}
+
+double S21Matrix::Min(int* row, int* col) const {
+  return FindExtremum(false, row, col);
+}
+
+double S21Matrix::Max(int* row, int* col) const {
+  return FindExtremum(true, row, col);
+}
+
+S21Matrix S21Matrix::RowSums() const {
+  S21Matrix result(rows_, rows_ ? 1 : 0);
+  const int grain = std::max(1, (1 << 14) / (cols_ + 1));
+  parallel::For(0, rows_, grain, [&](const int first, const int last) {
+    for (int i = first; i < last; ++i) {
+      const double* row = matrix_[i];
+      result.matrix_[i][0] =
+          PairwiseSum(0, cols_, [row](auto lanes, const size_t j) {
+            return simd::LoadAs<decltype(lanes)>(row + j);
+          });
+    }
+  });
+  return result;
+}
+
+S21Matrix S21Matrix::ColSums() const {
+  S21Matrix result(cols_ ? 1 : 0, cols_);
+  if (cols_) {
+    ColumnSums(result.matrix_[0], false);
+  }
+  return result;
+}
+
 void S21Matrix::SumMatrix(const S21Matrix& other) {
   if (!EqualSize(other)) {
     throw std::logic_error("SumMatrix: diffrent size");
   }
+  S21_STATS_OPERATION(stats::kSumMatrix, GetSize());
+  DetachMatrix();
   for (size_t i = 0; i < GetSize(); ++i) {
     matrix_[0][i] += other.matrix_[0][i];
   }
 }
 
-S21Matrix S21Matrix::operator+(const S21Matrix& other) {
+S21Matrix S21Matrix::operator+(const S21Matrix& other) const {
   S21Matrix result{*this};
   return result += other;
 }
@@ -102,12 +444,14 @@ void S21Matrix::SubMatrix(const S21Matrix& other) {
   if (!EqualSize(other)) {
     throw std::logic_error("SubMatrix: diffrent size");
   }
+  S21_STATS_OPERATION(stats::kSubMatrix, GetSize());
+  DetachMatrix();
   for (size_t i = 0; i < GetSize(); ++i) {
     matrix_[0][i] -= other.matrix_[0][i];
   }
 }
 
-S21Matrix S21Matrix::operator-(const S21Matrix& other) {
+S21Matrix S21Matrix::operator-(const S21Matrix& other) const {
   S21Matrix result{*this};
   return result -= other;
 }
@@ -117,18 +461,20 @@ S21Matrix& S21Matrix::operator-=(const S21Matrix& other) {
   return *this;
 }
 
-void S21Matrix::MulNumber(const double num) noexcept {
+void S21Matrix::MulNumber(const double num) {
+  S21_STATS_OPERATION(stats::kMulNumber, GetSize());
+  DetachMatrix();
   for (size_t i = 0; i < GetSize(); ++i) {
     matrix_[0][i] *= num;
   }
 }
 
-S21Matrix S21Matrix::operator*(const double num) noexcept {
+S21Matrix S21Matrix::operator*(const double num) const {
   S21Matrix result{*this};
   return result *= num;
 }
 
-S21Matrix& S21Matrix::operator*=(const double num) noexcept {
+S21Matrix& S21Matrix::operator*=(const double num) {
   MulNumber(num);
   return *this;
 }
@@ -138,17 +484,12 @@ void S21Matrix::MulMatrix(const S21Matrix& other) {
     throw std::logic_error("MulMatrix: M1(cols) != M2(rows)");
   }
   S21Matrix temp{rows_, other.cols_};
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < other.cols_; ++j) {
-      for (int k = 0; k < other.rows_; ++k) {
-        temp.matrix_[i][j] += matrix_[i][k] * other.matrix_[k][j];
-      }
-    }
-  }
+  Multiply(*this, other, temp);
+  temp.set_copy_on_write(copy_on_write_);
   *this = std::move(temp);
 }
 
-S21Matrix S21Matrix::operator*(const S21Matrix& other) {
+S21Matrix S21Matrix::operator*(const S21Matrix& other) const {
   S21Matrix result{*this};
   return result *= other;
 }
@@ -158,7 +499,136 @@ S21Matrix& S21Matrix::operator*=(const S21Matrix& other) {
   return *this;
 }
 
+// this = lhs * rhs, the current buffer is reused when it already has the
+// right shape and is not shared with an operand or a copy-on-write copy.
+void S21Matrix::Product(const S21Matrix& lhs, const S21Matrix& rhs) {
+  if (!EqualValues(lhs.cols_, rhs.rows_)) {
+    throw std::logic_error("Product: M1(cols) != M2(rows)");
+  }
+  if (matrix_ && (matrix_ == lhs.matrix_ || matrix_ == rhs.matrix_)) {
+    S21Matrix temp;
+    temp.Product(lhs, rhs);
+    temp.set_copy_on_write(copy_on_write_);
+    *this = std::move(temp);
+    return;
+  }
+  if (!EqualValues(rows_, lhs.rows_) || !EqualValues(cols_, rhs.cols_) ||
+      IsShared()) {
+    DeleteMatrix();
+    CreateObject(lhs.rows_, rhs.cols_);
+  }
+  Multiply(lhs, rhs, *this);
+}
+
+void S21Matrix::MulVector(const S21Matrix& x, S21Matrix& y,
+                          const bool transpose, const double alpha,
+                          const double beta) const {
+  const int x_size = transpose ? rows_ : cols_;
+  const int y_size = transpose ? cols_ : rows_;
+  if (x.rows_ != x_size || x.cols_ != (x_size ? 1 : 0)) {
+    throw std::logic_error("MulVector: x isn't a column of matching size");
+  }
+  if (y.rows_ != y_size || y.cols_ != (y_size ? 1 : 0)) {
+    throw std::logic_error("MulVector: y isn't a column of matching size");
+  }
+  double* const y_data = y.data();
+  if (y_size && x.matrix_ == y.matrix_) {
+    throw std::logic_error("MulVector: x and y share storage");
+  }
+  MulVector(x.data(), y_data, transpose, alpha, beta);
+}
+
+// y = alpha * op(A) * x + beta * y. The plain product is a dot product per
+// row, the transposed one accumulates scaled rows into a column strip of y,
+// so both read A row by row.
+void S21Matrix::MulVector(const double* x, double* y, const bool transpose,
+                          const double alpha,
+                          const double beta) const {
+  S21_STATS_OPERATION(stats::kMulVector, 2.0 * GetSize());
+  if (!transpose) {
+    const int grain = std::max(1, (1 << 14) / (cols_ + 1));
+    parallel::For(0, rows_, grain, [&](const int first, const int last) {
+      for (int i = first; i < last; ++i) {
+        const double* row = matrix_[i];
+        simd::Double2 even{};
+        simd::Double2 odd{};
+        int j = 0;
+        for (; j + 2 * simd::kWidth <= cols_; j += 2 * simd::kWidth) {
+          even += simd::Load(row + j) * simd::Load(x + j);
+          odd += simd::Load(row + j + simd::kWidth) *
+                 simd::Load(x + j + simd::kWidth);
+        }
+        double sum = simd::Sum(even + odd);
+        for (; j < cols_; ++j) {
+          sum += row[j] * x[j];
+        }
+        y[i] = beta ? alpha * sum + beta * y[i] : alpha * sum;
+      }
+    });
+    return;
+  }
+  const int grain = std::max(2 * simd::kWidth, (1 << 14) / (rows_ + 1));
+  parallel::For(0, cols_, grain, [&](const int first, const int last) {
+    for (int j = first; j < last; ++j) {
+      y[j] = beta ? beta * y[j] : 0.0;
+    }
+    for (int i = 0; i < rows_; ++i) {
+      const double* row = matrix_[i];
+      const double factor = alpha * x[i];
+      const simd::Double2 lanes = simd::Broadcast(factor);
+      int j = first;
+      for (; j + simd::kWidth <= last; j += simd::kWidth) {
+        simd::Store(y + j, simd::Load(y + j) + lanes * simd::Load(row + j));
+      }
+      for (; j < last; ++j) {
+        y[j] += factor * row[j];
+      }
+    }
+  });
+}
+
+// Each output row is the row of other scaled by every element of one row of
+// this, so the result is written block by block without temporaries.
+S21Matrix S21Matrix::Kronecker(const S21Matrix& other) const {
+  S21Matrix result(rows_ * other.rows_, cols_ * other.cols_);
+  S21_STATS_OPERATION(stats::kKronecker, result.GetSize());
+  const int grain = std::max(1, (1 << 14) / (result.cols_ + 1));
+  parallel::For(0, result.rows_, grain, [&](const int first, const int last) {
+    for (int r = first; r < last; ++r) {
+      const double* lhs = matrix_[r / other.rows_];
+      const double* rhs = other.matrix_[r % other.rows_];
+      double* out = result.matrix_[r];
+      for (int j = 0; j < cols_; ++j, out += other.cols_) {
+        const simd::Double2 scale = simd::Broadcast(lhs[j]);
+        int k = 0;
+        for (; k + simd::kWidth <= other.cols_; k += simd::kWidth) {
+          simd::Store(out + k, scale * simd::Load(rhs + k));
+        }
+        for (; k < other.cols_; ++k) {
+          out[k] = lhs[j] * rhs[k];
+        }
+      }
+    }
+  });
+  return result;
+}
+
+void S21Matrix::HadamardMul(const S21Matrix& other) {
+  if (!EqualSize(other)) {
+    throw std::logic_error("HadamardMul: diffrent size");
+  }
+  Hadamard(other, false);
+}
+
+void S21Matrix::HadamardDiv(const S21Matrix& other) {
+  if (!EqualSize(other)) {
+    throw std::logic_error("HadamardDiv: diffrent size");
+  }
+  Hadamard(other, true);
+}
+
 S21Matrix S21Matrix::Transpose() const noexcept {
+  S21_STATS_OPERATION(stats::kTranspose, 0);
   S21Matrix result(cols_, rows_);
   for (int i = 0; i < rows_; ++i) {
     for (int j = 0; j < cols_; ++j) {
@@ -170,15 +640,66 @@ S21Matrix S21Matrix::Transpose() const noexcept {
 
 double S21Matrix::Determinant() const {
   CheckNullAndSquare();
-  if (EqualValues(rows_, 1)) {
-    return matrix_[0][0];
+  S21_STATS_OPERATION(
+      stats::kDeterminant,
+      rows_ > kCofactorLimit ? 0.0 : small::kDeterminantFlops[rows_]);
+  return CalcDeterminant();
+}
+
+// Fraction-free Bareiss elimination, every intermediate value is a minor of
+// the matrix, so it is exact as long as it fits in 64 bits.
+long long S21Matrix::IntegerDeterminant() const {
+  __extension__ typedef __int128 Wide;
+  CheckNullAndSquare();
+  const double kLimit = 9223372036854775808.0;
+  std::vector<long long> values(GetSize());
+  for (size_t i = 0; i < GetSize(); ++i) {
+    const double value = matrix_[0][i];
+    if (value != trunc(value) || value >= kLimit || value < -kLimit) {
+      throw std::domain_error("IntegerDeterminant: non-integer element");
+    }
+    values[i] = static_cast<long long>(value);
   }
-  double result = 0.0;
-  for (int i = 0; i < cols_; ++i) {
-    S21Matrix temp = CalcMinor(0, i);
-    result += pow(-1, i) * (matrix_[0][i] * temp.Determinant());
+  const int size = rows_;
+  auto at = [&values, size](const int row, const int col) -> long long& {
+    return values[static_cast<size_t>(row) * size + col];
+  };
+  const Wide kMax = std::numeric_limits<long long>::max();
+  const Wide kMin = std::numeric_limits<long long>::min();
+  bool negative = false;
+  long long previous = 1;
+  for (int k = 0; k < size - 1; ++k) {
+    if (!at(k, k)) {
+      int pivot = k + 1;
+      while (pivot < size && !at(pivot, k)) {
+        ++pivot;
+      }
+      if (pivot == size) {
+        return 0;
+      }
+      for (int j = k; j < size; ++j) {
+        std::swap(at(k, j), at(pivot, j));
+      }
+      negative = !negative;
+    }
+    for (int i = k + 1; i < size; ++i) {
+      for (int j = k + 1; j < size; ++j) {
+        const Wide value = (static_cast<Wide>(at(i, j)) * at(k, k) -
+                            static_cast<Wide>(at(i, k)) * at(k, j)) /
+                           previous;
+        if (value > kMax || value < kMin) {
+          throw std::overflow_error("IntegerDeterminant: overflow");
+        }
+        at(i, j) = static_cast<long long>(value);
+      }
+    }
+    previous = at(k, k);
   }
-  return result;
+  const long long result = at(size - 1, size - 1);
+  if (negative && result == std::numeric_limits<long long>::min()) {
+    throw std::overflow_error("IntegerDeterminant: overflow");
+  }
+  return negative ? -result : result;
 }
 
 S21Matrix S21Matrix::CalcComplements() const {
@@ -186,13 +707,18 @@ S21Matrix S21Matrix::CalcComplements() const {
   if (EqualValues(rows_, 1)) {
     throw std::logic_error("Matrix 1x1 has no compliment");
   }
-  double determinant = 0.0;
+  S21_STATS_OPERATION(
+      stats::kCalcComplements,
+      rows_ > kCofactorLimit ? 0.0 : small::kAdjugateFlops[rows_]);
   S21Matrix result(cols_, rows_);
+  if (rows_ <= kCofactorLimit) {
+    SmallComplements(matrix_[0], rows_, result.matrix_[0]);
+    return result;
+  }
   for (int i = 0; i < rows_; ++i) {
     for (int j = 0; j < cols_; ++j) {
       S21Matrix minor = CalcMinor(i, j);
-      determinant = minor.Determinant();
-      result.matrix_[i][j] = pow(-1, (i + j)) * determinant;
+      result.matrix_[i][j] = pow(-1, (i + j)) * minor.CalcDeterminant();
     }
   }
   return result;
@@ -203,23 +729,127 @@ S21Matrix S21Matrix::InverseMatrix() const {
   if (EqualValues(rows_, 1)) {
     throw std::logic_error("Matrix 1x1 can't be inversed");
   }
-  double determinant = Determinant();
-  if (!determinant) {
-    throw std::logic_error("Determinant is zero");
+  S21_STATS_OPERATION(stats::kInverseMatrix, GetSize());
+  if (rows_ > kCofactorLimit) {
+    return S21LU(*this).Inverse();
   }
-  S21Matrix result = Transpose().CalcComplements();
-  result.MulNumber(1 / determinant);
+  S21Matrix result(rows_);
+  SmallInverse(matrix_[0], rows_, result.matrix_[0]);
   return result;
 }
 
-void S21Matrix::Fill() noexcept { Fill(1); }
+S21Matrix S21Matrix::Power(const int power) const {
+  CheckNullAndSquare();
+  S21_STATS_OPERATION(stats::kPower, 0);
+  S21Matrix result(rows_);
+  S21Matrix base = power < 0 ? S21LU(*this).Inverse() : *this;
+  S21Matrix workspace(rows_);
+  result.FillIdentity();
+  unsigned exponent = power < 0 ? 0U - static_cast<unsigned>(power)
+                                : static_cast<unsigned>(power);
+  while (exponent) {
+    if (exponent & 1U) {
+      Multiply(result, base, workspace);
+      result.SwapObject(workspace);
+    }
+    exponent >>= 1U;
+    if (exponent) {
+      Multiply(base, base, workspace);
+      base.SwapObject(workspace);
+    }
+  }
+  return result;
+}
 
-void S21Matrix::Fill(const int num) noexcept {
+S21Matrix S21Matrix::Exp() const {
+  CheckNullAndSquare();
+  const int kPadeDegree = 6;
+  S21_STATS_OPERATION(stats::kExp, 4.0 * kPadeDegree * GetSize());
+  const double norm = NormInf();
+  if (!isfinite(norm)) {
+    throw std::invalid_argument("Exp: matrix has non-finite elements");
+  }
+  const int squarings =
+      norm > 0.5 ? std::max(0, static_cast<int>(ceil(log2(norm / 0.5)))) : 0;
+  S21Matrix scaled{*this};
+  scaled.MulNumber(ldexp(1.0, -squarings));
+  S21Matrix numerator(rows_);
+  S21Matrix denominator(rows_);
+  S21Matrix term(rows_);
+  S21Matrix workspace(rows_);
+  numerator.FillIdentity();
+  denominator.FillIdentity();
+  term.FillIdentity();
+  double coefficient = 1.0;
+  for (int k = 1; k <= kPadeDegree; ++k) {
+    coefficient *= static_cast<double>(kPadeDegree - k + 1) /
+                   (k * (2 * kPadeDegree - k + 1));
+    Multiply(scaled, term, workspace);
+    term.SwapObject(workspace);
+    const double sign = k % 2 ? -1.0 : 1.0;
+    for (size_t i = 0; i < GetSize(); ++i) {
+      numerator.matrix_[0][i] += coefficient * term.matrix_[0][i];
+      denominator.matrix_[0][i] += sign * coefficient * term.matrix_[0][i];
+    }
+  }
+  numerator = S21LU(denominator).Solve(numerator);
+  for (int i = 0; i < squarings; ++i) {
+    Multiply(numerator, numerator, workspace);
+    numerator.SwapObject(workspace);
+  }
+  return numerator;
+}
+
+void S21Matrix::Fill() { Fill(1); }
+
+void S21Matrix::Fill(const int num) {
+  DetachMatrix();
   for (size_t i = 0; i < GetSize(); ++i) {
     matrix_[0][i] = i + num;
   }
 }
 
+void S21Matrix::FillConstant(const double value) {
+  DetachMatrix();
+  const int grain = std::max(1, (1 << 14) / (cols_ + 1));
+  parallel::For(0, rows_, grain, [&](const int first, const int last) {
+    std::fill(matrix_[first], matrix_[first] + (last - first) * cols_, value);
+  });
+}
+
+void S21Matrix::FillDiagonal(const double value) {
+  FillConstant(0.0);
+  for (int i = 0; i < std::min(rows_, cols_); ++i) {
+    matrix_[i][i] = value;
+  }
+}
+
+// values holds min(rows, cols) diagonal elements.
+void S21Matrix::FillDiagonal(const double* values) {
+  FillConstant(0.0);
+  for (int i = 0; i < std::min(rows_, cols_); ++i) {
+    matrix_[i][i] = values[i];
+  }
+}
+
+void S21Matrix::FillIdentity() { FillDiagonal(1.0); }
+
+// Uniform values lie in [location, location + scale), normal ones have mean
+// location and standard deviation scale. Element i depends only on seed and
+// i, so the result is the same for any thread count and any shape with the
+// same number of elements.
+void S21Matrix::FillRandom(const unsigned long long seed,
+                           const Distribution distribution,
+                           const double location, const double scale) {
+  DetachMatrix();
+  const int grain = std::max(1, (1 << 12) / (cols_ + 1));
+  parallel::For(0, rows_, grain, [&](const int first, const int last) {
+    RandomRange(matrix_[0], static_cast<size_t>(first) * cols_,
+                static_cast<size_t>(last) * cols_, seed,
+                distribution == kNormal, location, scale);
+  });
+}
+
 void S21Matrix::CreateObject(const int& rows, const int& cols) {
   if (rows < 0 || cols < 0) {
     throw std::invalid_argument("Constructor: negative rows or cols");
@@ -229,14 +859,55 @@ void S21Matrix::CreateObject(const int& rows, const int& cols) {
 }
 
 void S21Matrix::CopyObject(const S21Matrix& other) noexcept {
-  CreateObject(other.rows_, other.cols_);
-  CopyMatrix(other);
+  copy_on_write_ = other.copy_on_write_;
+  if (other.references_) {
+    SetSize(other.rows_, other.cols_);
+    matrix_ = other.matrix_;
+    capacity_ = other.capacity_;
+    row_capacity_ = other.row_capacity_;
+    references_ = other.references_;
+    references_->fetch_add(1);
+  } else {
+    CreateObject(other.rows_, other.cols_);
+    CopyMatrix(other);
+  }
 }
 
+// An inline buffer can't change hands, its contents are copied into the inline
+// buffer of this object instead.
 void S21Matrix::MoveObject(S21Matrix& other) noexcept {
   SetSize(other.rows_, other.cols_);
+  std::swap(copy_on_write_, other.copy_on_write_);
+  if (other.IsInline()) {
+    CreateMatrix();
+    CopyMatrix(other);
+    other.matrix_ = nullptr;
+    other.capacity_ = 0;
+    other.row_capacity_ = 0;
+  } else {
+    std::swap(matrix_, other.matrix_);
+    std::swap(references_, other.references_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(row_capacity_, other.row_capacity_);
+  }
   other.SetSize(0, 0);
+}
+
+void S21Matrix::SwapObject(S21Matrix& other) noexcept {
+  if (IsInline() || other.IsInline()) {
+    S21Matrix temp;
+    temp.MoveObject(other);
+    other.MoveObject(*this);
+    MoveObject(temp);
+    return;
+  }
+  std::swap(rows_, other.rows_);
+  std::swap(cols_, other.cols_);
   std::swap(matrix_, other.matrix_);
+  std::swap(copy_on_write_, other.copy_on_write_);
+  std::swap(references_, other.references_);
+  std::swap(capacity_, other.capacity_);
+  std::swap(row_capacity_, other.row_capacity_);
 }
 
 void S21Matrix::DeleteObject() noexcept {
@@ -244,13 +915,30 @@ void S21Matrix::DeleteObject() noexcept {
   DeleteMatrix();
 }
 
-void S21Matrix::CreateMatrix() noexcept {
-  if (rows_) {
+// Matrices of up to kInlineSize elements live in the object itself and never
+// take part in copy-on-write sharing, copying them is as cheap as sharing.
+void S21Matrix::CreateMatrix() {
+  if (rows_ && GetSize() <= static_cast<size_t>(kInlineSize)) {
+    matrix_ = inline_rows_;
+    capacity_ = kInlineSize;
+    row_capacity_ = kInlineSize;
+    std::fill_n(inline_data_, GetSize(), 0.0);
+    for (int i = 0; i < rows_; ++i) {
+      matrix_[i] = inline_data_ + cols_ * i;
+    }
+  } else if (rows_) {
+    S21_STATS_ALLOCATION(rows_ * sizeof(double*));
+    S21_STATS_ALLOCATION(GetSize() * sizeof(double));
     matrix_ = new double* [rows_] { 0 };
-    matrix_[0] = new double[GetSize()]{0};
+    matrix_[0] = numa::Allocate(GetSize(), cols_);
+    capacity_ = GetSize();
+    row_capacity_ = rows_;
     for (int i = 1; i < rows_; ++i) {
       matrix_[i] = *matrix_ + cols_ * i;
     }
+    if (copy_on_write_) {
+      references_ = new std::atomic<long>{1};
+    }
   }
 }
 
@@ -265,15 +953,102 @@ void S21Matrix::CopyMatrix(const S21Matrix& other) noexcept {
 }
 
 void S21Matrix::DeleteMatrix() {
+  const size_t capacity = capacity_;
+  capacity_ = 0;
+  row_capacity_ = 0;
+  if (IsInline()) {
+    matrix_ = nullptr;
+    return;
+  }
+  if (references_ != nullptr) {
+    std::atomic<long>* references = references_;
+    references_ = nullptr;
+    if (references->fetch_sub(1) > 1) {
+      matrix_ = nullptr;
+      return;
+    }
+    delete references;
+  }
   if (matrix_ != nullptr) {
     if (matrix_[0] != nullptr) {
-      delete[](*matrix_);
+      numa::Deallocate(*matrix_, capacity);
     }
     delete[] matrix_;
     matrix_ = nullptr;
   }
 }
 
+// Gives this object a private copy of a buffer shared with other
+// copy-on-write matrices. References returned by operator() before a copy was
+// made keep pointing into the shared buffer.
+void S21Matrix::DetachMatrix() {
+  if (IsShared()) {
+    S21Matrix copy(rows_, cols_);
+    copy.CopyMatrix(*this);
+    copy.copy_on_write_ = copy_on_write_;
+    DeleteMatrix();
+    MoveObject(copy);
+    if (!IsInline()) {
+      references_ = new std::atomic<long>{1};
+    }
+  }
+}
+
+// Moves the values into a heap buffer with room for capacity values and
+// row_capacity rows, the shape stays the same.
+void S21Matrix::ReserveMatrix(const size_t capacity, const int row_capacity) {
+  S21_STATS_ALLOCATION(row_capacity * sizeof(double*));
+  S21_STATS_ALLOCATION(capacity * sizeof(double));
+  double** rows = new double* [row_capacity] { 0 };
+  try {
+    rows[0] = numa::Allocate(capacity, cols_);
+  } catch (...) {
+    delete[] rows;
+    throw;
+  }
+  memcpy(rows[0], matrix_[0], GetSize() * sizeof(double));
+  const bool copy_on_write = copy_on_write_;
+  DeleteMatrix();
+  matrix_ = rows;
+  capacity_ = capacity;
+  row_capacity_ = row_capacity;
+  for (int i = 1; i < rows_; ++i) {
+    matrix_[i] = matrix_[0] + static_cast<size_t>(cols_) * i;
+  }
+  if (copy_on_write) {
+    references_ = new std::atomic<long>{1};
+  }
+}
+
+// Changes the shape inside the current buffer, which must be large enough.
+// Rows move towards the front when they get shorter and towards the back,
+// last row first, when they get longer; new elements are zero.
+void S21Matrix::ResizeMatrix(const int rows, const int cols) noexcept {
+  double* values = matrix_[0];
+  const int kept = std::min(rows, rows_);
+  if (cols < cols_) {
+    for (int i = 1; i < kept; ++i) {
+      memmove(values + static_cast<size_t>(i) * cols,
+              values + static_cast<size_t>(i) * cols_, cols * sizeof(double));
+    }
+  } else if (cols > cols_) {
+    for (int i = kept - 1; i >= 0; --i) {
+      double* row = values + static_cast<size_t>(i) * cols;
+      memmove(row, values + static_cast<size_t>(i) * cols_,
+              cols_ * sizeof(double));
+      std::fill(row + cols_, row + cols, 0.0);
+    }
+  }
+  std::fill(values + static_cast<size_t>(kept) * cols,
+            values + static_cast<size_t>(rows) * cols, 0.0);
+  SetSize(rows, cols);
+  for (int i = 1; i < rows_; ++i) {
+    matrix_[i] = values + static_cast<size_t>(cols_) * i;
+  }
+}
+
+bool S21Matrix::IsInline() const noexcept { return matrix_ == inline_rows_; }
+
 bool S21Matrix::EqualValues(const int& val_1, const int& val_2) const noexcept {
   if (val_1 != val_2) {
     return false;
@@ -298,7 +1073,7 @@ void S21Matrix::SetSize(const int& rows, const int& cols) noexcept {
   }
 }
 
-size_t S21Matrix::GetSize() {
+size_t S21Matrix::GetSize() const noexcept {
   return static_cast<size_t>(rows_) * static_cast<size_t>(cols_);
 }
 
@@ -322,7 +1097,7 @@ void S21Matrix::CheckAndChange(const int& cheked, int& changed) noexcept {
   }
 }
 
-S21Matrix operator*(const int num, const S21Matrix& matrix) noexcept {
+S21Matrix operator*(const int num, const S21Matrix& matrix) {
   S21Matrix result{matrix};
   return result * num;
 }
@@ -341,6 +1116,13 @@ std::ostream& operator<<(std::ostream& stream, const S21Matrix& matrix) {
   return stream;
 }
 
+double S21Matrix::CalcDeterminant() const {
+  if (rows_ > kCofactorLimit) {
+    return S21LU(*this).Determinant();
+  }
+  return SmallDeterminant(matrix_[0], rows_);
+}
+
 S21Matrix S21Matrix::CalcMinor(const int row, const int col) const noexcept {
   S21Matrix result(rows_ - 1, cols_ - 1);
   for (int i = 0, minor_row = 0; i < rows_; ++i) {
@@ -364,4 +1146,207 @@ void S21Matrix::CheckNullAndSquare() const {
   }
 }
 
+// Elements are compared a block at a time with vector masks and no
+// branches, the first block with a mismatch (or NaN) stops the scan.
+bool S21Matrix::ApproxEqualRange(const double* lhs, const double* rhs,
+                                 const size_t size, const double abs_tol,
+                                 const double rel_tol) noexcept {
+  const size_t kBlock = 256;
+  const simd::Double2 absolute = simd::Broadcast(abs_tol);
+  const simd::Double2 relative = simd::Broadcast(rel_tol);
+  size_t i = 0;
+  while (i + kBlock <= size) {
+    simd::Mask2 mismatch{};
+    for (const size_t last = i + kBlock; i < last; i += simd::kWidth) {
+      const simd::Double2 left = simd::Load(lhs + i);
+      const simd::Double2 right = simd::Load(rhs + i);
+      const simd::Double2 difference = simd::Abs(left - right);
+      const simd::Double2 magnitude =
+          simd::Max(simd::Abs(left), simd::Abs(right));
+      mismatch |= ~(left == right) & ~(difference <= absolute) &
+                  ~(difference <= relative * magnitude);
+    }
+    if (simd::Any(mismatch)) {
+      return false;
+    }
+  }
+  for (; i < size; ++i) {
+    const double difference = fabs(lhs[i] - rhs[i]);
+    const double magnitude = std::max(fabs(lhs[i]), fabs(rhs[i]));
+    if (lhs[i] != rhs[i] && !(difference <= abs_tol) &&
+        !(difference <= rel_tol * magnitude)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Calls function on contiguous runs of whole rows, one run per thread.
+void S21Matrix::ForEachChunk(
+    const std::function<void(double*, size_t)>& function) {
+  S21_STATS_OPERATION(stats::kApply, GetSize());
+  DetachMatrix();
+  const int grain = std::max(1, (1 << 14) / (cols_ + 1));
+  parallel::For(0, rows_, grain, [&](const int first, const int last) {
+    function(matrix_[first], static_cast<size_t>(last - first) * cols_);
+  });
+}
+
+// Runs after DetachMatrix, so other may be this object or share its buffer.
+void S21Matrix::Hadamard(const S21Matrix& other, const bool divide) {
+  S21_STATS_OPERATION(stats::kHadamard, GetSize());
+  DetachMatrix();
+  const int grain = std::max(1, (1 << 16) / (cols_ + 1));
+  parallel::For(0, rows_, grain, [&](const int first, const int last) {
+    const size_t begin = static_cast<size_t>(first) * cols_;
+    const size_t end = static_cast<size_t>(last) * cols_;
+    double* values = matrix_[0];
+    const double* factors = other.matrix_[0];
+    size_t i = begin;
+    for (; i + simd::kWidth <= end; i += simd::kWidth) {
+      const simd::Double2 lhs = simd::Load(values + i);
+      const simd::Double2 rhs = simd::Load(factors + i);
+      simd::Store(values + i, divide ? lhs / rhs : lhs * rhs);
+    }
+    for (; i < end; ++i) {
+      values[i] = divide ? values[i] / factors[i] : values[i] * factors[i];
+    }
+  });
+}
+
+// Kahan-compensated sums down the columns, columns are split between
+// threads so every row is still read sequentially.
+void S21Matrix::ColumnSums(double* result, const bool absolute) const {
+  const int grain = std::max(1, (1 << 14) / (rows_ + 1));
+  parallel::For(0, cols_, grain, [&](const int first, const int last) {
+    std::vector<double> compensation(last - first);
+    std::fill(result + first, result + last, 0.0);
+    for (int i = 0; i < rows_; ++i) {
+      const double* row = matrix_[i];
+      for (int j = first; j < last; ++j) {
+        const double value =
+            (absolute ? fabs(row[j]) : row[j]) - compensation[j - first];
+        const double total = result[j] + value;
+        compensation[j - first] = (total - result[j]) - value;
+        result[j] = total;
+      }
+    }
+  });
+}
+
+// NaNs are skipped, a matrix of NaNs only yields NaN at (1, 1).
+double S21Matrix::FindExtremum(const bool maximum, int* row, int* col) const {
+  if (!GetSize()) {
+    throw std::logic_error("Operation with NULL mattrix");
+  }
+  const double* values = data();
+  const size_t size = GetSize();
+  const double infinity = std::numeric_limits<double>::infinity();
+  simd::Double2 best = simd::Broadcast(maximum ? -infinity : infinity);
+  size_t i = 0;
+  for (; i + simd::kWidth <= size; i += simd::kWidth) {
+    const simd::Double2 value = simd::Load(values + i);
+    best = maximum ? simd::Max(value, best) : simd::Min(value, best);
+  }
+  double result = maximum ? std::max(best[0], best[1])
+                          : std::min(best[0], best[1]);
+  for (; i < size; ++i) {
+    result = maximum ? std::max(result, values[i]) : std::min(result, values[i]);
+  }
+  size_t index = std::find(values, values + size, result) - values;
+  if (index == size) {
+    index = 0;
+    result = values[0];
+  }
+  if (row) {
+    *row = static_cast<int>(index / cols_) + 1;
+  }
+  if (col) {
+    *col = static_cast<int>(index % cols_) + 1;
+  }
+  return result;
+}
+
+// Pairwise summation of term(i) over [first, last), the leaves are summed
+// with two vector accumulators. The error grows as O(log n) instead of O(n).
+template <typename Term>
+double S21Matrix::PairwiseSum(const size_t first, const size_t last,
+                              const Term& term) noexcept {
+  const size_t kLeaf = 256;
+  if (last - first > kLeaf) {
+    const size_t middle = first + (last - first) / 2;
+    return PairwiseSum(first, middle, term) + PairwiseSum(middle, last, term);
+  }
+  simd::Double2 even{};
+  simd::Double2 odd{};
+  size_t i = first;
+  for (; i + 2 * simd::kWidth <= last; i += 2 * simd::kWidth) {
+    even += term(simd::Double2{}, i);
+    odd += term(simd::Double2{}, i + simd::kWidth);
+  }
+  double result = simd::Sum(even + odd);
+  for (; i < last; ++i) {
+    result += term(0.0, i);
+  }
+  return result;
+}
+
+// Pairwise sums of fixed-size chunks computed in parallel and then summed
+// pairwise, so the result does not depend on the number of threads.
+template <typename Term>
+double S21Matrix::ChunkedSum(const size_t size, const Term& term) {
+  const size_t kChunk = 1 << 16;
+  const int chunks = static_cast<int>((size + kChunk - 1) / kChunk);
+  if (chunks < 2) {
+    return PairwiseSum(0, size, term);
+  }
+  std::vector<double> partial(chunks);
+  parallel::For(0, chunks, 1, [&](const int first, const int last) {
+    for (int chunk = first; chunk < last; ++chunk) {
+      const size_t offset = static_cast<size_t>(chunk) * kChunk;
+      partial[chunk] =
+          PairwiseSum(offset, std::min(size, offset + kChunk), term);
+    }
+  });
+  const double* sums = partial.data();
+  return PairwiseSum(0, chunks, [sums](auto lanes, const size_t i) {
+    return simd::LoadAs<decltype(lanes)>(sums + i);
+  });
+}
+
+// Cache-blocked i-k-j product, rows of the result are split between threads.
+// The result must be preallocated and must not alias lhs or rhs.
+void S21Matrix::Multiply(const S21Matrix& lhs, const S21Matrix& rhs,
+                         S21Matrix& result) {
+  const int kBlockInner = 128;
+  const int kBlockCols = 512;
+  const int inner = lhs.cols_;
+  const int cols = rhs.cols_;
+  const long work = static_cast<long>(inner) * cols;
+  S21_STATS_OPERATION(stats::kMulMatrix, 2.0 * lhs.rows_ * work);
+  const int grain = static_cast<int>(std::max(1L, (1L << 20) / (work + 1)));
+  parallel::For(0, lhs.rows_, grain, [&](const int first, const int last) {
+    for (int i = first; i < last; ++i) {
+      std::fill_n(result.matrix_[i], cols, 0.0);
+    }
+    for (int j0 = 0; j0 < cols; j0 += kBlockCols) {
+      const int j1 = std::min(cols, j0 + kBlockCols);
+      for (int k0 = 0; k0 < inner; k0 += kBlockInner) {
+        const int k1 = std::min(inner, k0 + kBlockInner);
+        for (int i = first; i < last; ++i) {
+          double* out = result.matrix_[i];
+          const double* row = lhs.matrix_[i];
+          for (int k = k0; k < k1; ++k) {
+            const double value = row[k];
+            const double* other = rhs.matrix_[k];
+            for (int j = j0; j < j1; ++j) {
+              out[j] += value * other[j];
+            }
+          }
+        }
+      }
+    }
+  });
+}
+
 };  // namespace s21
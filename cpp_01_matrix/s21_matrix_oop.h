@@ -1,15 +1,146 @@
 #ifndef CPP1_S21_MATRIXPLUS_4_S21_MATRIX_OOP_H_
 #define CPP1_S21_MATRIXPLUS_4_S21_MATRIX_OOP_H_
 
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iterator>
 #include <ostream>
+#include <type_traits>
+
+#include "s21_simd.h"
 
 namespace s21 {
 
 class S21Matrix {
-  friend S21Matrix operator*(const int num, const S21Matrix &matrix) noexcept;
+  friend S21Matrix operator*(const int num, const S21Matrix &matrix);
   friend std::ostream &operator<<(std::ostream &stream,
                                   const S21Matrix &matrix);
 
+ public:
+  template <typename T>
+  class RowSpan;
+  template <typename T>
+  class RowIterator;
+  template <typename T>
+  class RowRange;
+
+  using value_type = double;
+  using iterator = double *;
+  using const_iterator = const double *;
+  using row_iterator = RowIterator<double>;
+  using const_row_iterator = RowIterator<const double>;
+
+  enum Distribution { kUniform, kNormal };
+
+ public:
+  template <typename T>
+  class RowSpan {
+   public:
+    RowSpan(T *data, const int size) noexcept : data_(data), size_(size) {}
+    T *begin() const noexcept { return data_; }
+    T *end() const noexcept { return data_ + size_; }
+    T *data() const noexcept { return data_; }
+    int size() const noexcept { return size_; }
+    T &operator[](const int col) const noexcept { return data_[col]; }
+
+   private:
+    T *data_;
+    int size_;
+  };
+
+ public:
+  template <typename T>
+  class RowIterator {
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = RowSpan<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = RowSpan<T>;
+
+    RowIterator() = default;
+    RowIterator(T *data, const int cols) noexcept : data_(data), cols_(cols) {}
+    reference operator*() const noexcept { return {data_, cols_}; }
+    reference operator[](const difference_type n) const noexcept {
+      return *(*this + n);
+    }
+    RowIterator &operator++() noexcept { return *this += 1; }
+    RowIterator &operator--() noexcept { return *this -= 1; }
+    RowIterator operator++(int) noexcept {
+      RowIterator result{*this};
+      ++*this;
+      return result;
+    }
+    RowIterator operator--(int) noexcept {
+      RowIterator result{*this};
+      --*this;
+      return result;
+    }
+    RowIterator &operator+=(const difference_type n) noexcept {
+      data_ += n * cols_;
+      return *this;
+    }
+    RowIterator &operator-=(const difference_type n) noexcept {
+      return *this += -n;
+    }
+    RowIterator operator+(const difference_type n) const noexcept {
+      RowIterator result{*this};
+      return result += n;
+    }
+    friend RowIterator operator+(const difference_type n,
+                                 const RowIterator &it) noexcept {
+      return it + n;
+    }
+    RowIterator operator-(const difference_type n) const noexcept {
+      RowIterator result{*this};
+      return result -= n;
+    }
+    difference_type operator-(const RowIterator &other) const noexcept {
+      return cols_ ? (data_ - other.data_) / cols_ : 0;
+    }
+    bool operator==(const RowIterator &other) const noexcept {
+      return data_ == other.data_;
+    }
+    bool operator!=(const RowIterator &other) const noexcept {
+      return data_ != other.data_;
+    }
+    bool operator<(const RowIterator &other) const noexcept {
+      return data_ < other.data_;
+    }
+    bool operator>(const RowIterator &other) const noexcept {
+      return other < *this;
+    }
+    bool operator<=(const RowIterator &other) const noexcept {
+      return !(other < *this);
+    }
+    bool operator>=(const RowIterator &other) const noexcept {
+      return !(*this < other);
+    }
+
+   private:
+    T *data_{nullptr};
+    int cols_{0};
+  };
+
+ public:
+  template <typename T>
+  class RowRange {
+   public:
+    RowRange(T *data, const int rows, const int cols) noexcept
+        : data_(data), rows_(rows), cols_(cols) {}
+    RowIterator<T> begin() const noexcept { return {data_, cols_}; }
+    RowIterator<T> end() const noexcept {
+      return {data_ + static_cast<std::ptrdiff_t>(rows_) * cols_, cols_};
+    }
+    int size() const noexcept { return rows_; }
+
+   private:
+    T *data_;
+    int rows_;
+    int cols_;
+  };
+
  public:
   S21Matrix() = default;
   S21Matrix(int size);
@@ -26,49 +157,148 @@ class S21Matrix {
   void set_rows(const int rows);
   void set_cols(const int cols);
   void set_size(const int rows, const int cols);
+  size_t get_capacity() const noexcept;
+  void Reserve(const int rows, const int cols);
+  bool get_copy_on_write() const noexcept;
+  void set_copy_on_write(const bool enabled);
+  bool IsShared() const noexcept;
+  double *operator[](const int row);
+  const double *operator[](const int row) const noexcept;
+  double *data();
+  const double *data() const noexcept;
+  iterator begin();
+  iterator end();
+  const_iterator begin() const noexcept;
+  const_iterator end() const noexcept;
+  const_iterator cbegin() const noexcept;
+  const_iterator cend() const noexcept;
+  RowSpan<double> Row(const int row);
+  RowSpan<const double> Row(const int row) const noexcept;
+  RowRange<double> Rows();
+  RowRange<const double> Rows() const noexcept;
   bool EqMatrix(const S21Matrix &other) const noexcept;
   bool operator==(const S21Matrix &other) const noexcept;
+  bool ApproxEqual(const S21Matrix &other, const double abs_tol = 1e-7,
+                   const double rel_tol = 0.0) const;
+  double Trace() const;
+  double Sum() const;
+  double Dot(const S21Matrix &other) const;
+  double NormFrobenius() const;
+  double Norm1() const;
+  double NormInf() const;
+  double Min(int *row = nullptr, int *col = nullptr) const;
+  double Max(int *row = nullptr, int *col = nullptr) const;
+  S21Matrix RowSums() const;
+  S21Matrix ColSums() const;
   void SumMatrix(const S21Matrix &other);
-  S21Matrix operator+(const S21Matrix &other);
+  S21Matrix operator+(const S21Matrix &other) const;
   S21Matrix &operator+=(const S21Matrix &other);
   void SubMatrix(const S21Matrix &other);
-  S21Matrix operator-(const S21Matrix &other);
+  S21Matrix operator-(const S21Matrix &other) const;
   S21Matrix &operator-=(const S21Matrix &other);
-  void MulNumber(const double num) noexcept;
-  S21Matrix operator*(const double num) noexcept;
-  S21Matrix &operator*=(const double num) noexcept;
+  void MulNumber(const double num);
+  S21Matrix operator*(const double num) const;
+  S21Matrix &operator*=(const double num);
   void MulMatrix(const S21Matrix &other);
-  S21Matrix operator*(const S21Matrix &other);
+  S21Matrix operator*(const S21Matrix &other) const;
   S21Matrix &operator*=(const S21Matrix &other);
+  void Product(const S21Matrix &lhs, const S21Matrix &rhs);
+  void MulVector(const S21Matrix &x, S21Matrix &y, const bool transpose = false,
+                 const double alpha = 1.0, const double beta = 0.0) const;
+  void MulVector(const double *x, double *y, const bool transpose = false,
+                 const double alpha = 1.0,
+                 const double beta = 0.0) const;
+  S21Matrix Kronecker(const S21Matrix &other) const;
+  void HadamardMul(const S21Matrix &other);
+  void HadamardDiv(const S21Matrix &other);
+  template <typename Function>
+  void Apply(const Function &function);
   S21Matrix Transpose() const noexcept;
   double Determinant() const;
+  long long IntegerDeterminant() const;
   S21Matrix CalcComplements() const;
   S21Matrix InverseMatrix() const;
-  void Fill() noexcept;
-  void Fill(const int num) noexcept;
+  S21Matrix Power(const int power) const;
+  S21Matrix Exp() const;
+  void Fill();
+  void Fill(const int num);
+  void FillConstant(const double value);
+  void FillDiagonal(const double value);
+  void FillDiagonal(const double *values);
+  void FillIdentity();
+  void FillRandom(const unsigned long long seed,
+                  const Distribution distribution = kUniform,
+                  const double location = 0.0, const double scale = 1.0);
 
  private:
   void CreateObject(const int &rows, const int &cols);
   void CopyObject(const S21Matrix &other) noexcept;
   void MoveObject(S21Matrix &other) noexcept;
+  void SwapObject(S21Matrix &other) noexcept;
   void DeleteObject() noexcept;
-  void CreateMatrix() noexcept;
+  void CreateMatrix();
   void CopyMatrix(const S21Matrix &other) noexcept;
   void DeleteMatrix();
+  void DetachMatrix();
+  bool IsInline() const noexcept;
+  void ReserveMatrix(const size_t capacity, const int row_capacity);
+  void ResizeMatrix(const int rows, const int cols) noexcept;
   bool EqualValues(const int &val_1, const int &val_2) const noexcept;
   bool EqualSize(const S21Matrix &other) const noexcept;
   bool ValidSize(const int &rows, const int &cols) const noexcept;
   void SetSize(const int &rows, const int &cols) noexcept;
-  size_t GetSize();
+  size_t GetSize() const noexcept;
   bool ValidElement(const int &row, const int &col) const noexcept;
   double &FindElement(const int &row, const int &col) const;
   void CheckAndChange(const int &cheked, int &changed) noexcept;
+  double CalcDeterminant() const;
   S21Matrix CalcMinor(const int row, const int col) const noexcept;
   void CheckNullAndSquare() const;
+  void ColumnSums(double *result, const bool absolute) const;
+  void ForEachChunk(const std::function<void(double *, size_t)> &function);
+  void Hadamard(const S21Matrix &other, const bool divide);
+  double FindExtremum(const bool maximum, int *row, int *col) const;
+  template <typename Term>
+  static double PairwiseSum(const size_t first, const size_t last,
+                            const Term &term) noexcept;
+  template <typename Term>
+  static double ChunkedSum(const size_t size, const Term &term);
+  static void Multiply(const S21Matrix &lhs, const S21Matrix &rhs,
+                       S21Matrix &result);
+  static bool ApproxEqualRange(const double *lhs, const double *rhs,
+                               const size_t size, const double abs_tol,
+                               const double rel_tol) noexcept;
+  static constexpr int kCofactorLimit = 4;
+  static constexpr int kInlineSize = 16;
   int rows_{0};
   int cols_{0};
   double **matrix_{nullptr};
+  bool copy_on_write_{false};
+  std::atomic<long> *references_{nullptr};
+  size_t capacity_{0};
+  int row_capacity_{0};
+  double *inline_rows_[kInlineSize];
+  double inline_data_[kInlineSize];
 };
+
+// Replaces every element x with function(x). A function that also accepts
+// simd::Double2 is called on two elements at a time. Large matrices are split
+// between threads, so function must be safe to call concurrently.
+template <typename Function>
+void S21Matrix::Apply(const Function &function) {
+  ForEachChunk([&function](double *values, const size_t size) {
+    size_t i = 0;
+    if constexpr (std::is_invocable_r_v<simd::Double2, const Function &,
+                                        simd::Double2>) {
+      for (; i + simd::kWidth <= size; i += simd::kWidth) {
+        simd::Store(values + i, function(simd::Load(values + i)));
+      }
+    }
+    for (; i < size; ++i) {
+      values[i] = function(values[i]);
+    }
+  });
+}
 }  // namespace s21
 
 #endif  // CPP1_S21_MATRIXPLUS_4_S21_MATRIX_OOP_H_
@@ -0,0 +1,98 @@
+#include "s21_matrix_stats.h"
+
+#include <atomic>
+
+namespace s21 {
+namespace stats {
+
+namespace {
+
+struct Counters {
+  std::atomic<unsigned long long> allocations{0};
+  std::atomic<unsigned long long> bytes{0};
+  std::atomic<unsigned long long> calls[kOperationCount]{};
+  std::atomic<unsigned long long> flops[kOperationCount]{};
+  std::atomic<unsigned long long> latency[kOperationCount][kLatencyBuckets]{};
+};
+
+Counters &GetCounters() noexcept {
+  static Counters counters;
+  return counters;
+}
+
+bool ValidOperation(const Operation operation) noexcept {
+  return operation >= 0 && operation < kOperationCount;
+}
+
+}  // namespace
+
+unsigned long long GetAllocations() noexcept {
+  return GetCounters().allocations.load(std::memory_order_relaxed);
+}
+
+unsigned long long GetAllocatedBytes() noexcept {
+  return GetCounters().bytes.load(std::memory_order_relaxed);
+}
+
+unsigned long long GetCalls(const Operation operation) noexcept {
+  if (!ValidOperation(operation)) {
+    return 0;
+  }
+  return GetCounters().calls[operation].load(std::memory_order_relaxed);
+}
+
+unsigned long long GetFlops(const Operation operation) noexcept {
+  if (!ValidOperation(operation)) {
+    return 0;
+  }
+  return GetCounters().flops[operation].load(std::memory_order_relaxed);
+}
+
+Histogram GetLatencyHistogram(const Operation operation) noexcept {
+  Histogram result{};
+  if (ValidOperation(operation)) {
+    for (int i = 0; i < kLatencyBuckets; ++i) {
+      result[i] =
+          GetCounters().latency[operation][i].load(std::memory_order_relaxed);
+    }
+  }
+  return result;
+}
+
+void Reset() noexcept {
+  Counters &counters = GetCounters();
+  counters.allocations.store(0, std::memory_order_relaxed);
+  counters.bytes.store(0, std::memory_order_relaxed);
+  for (int i = 0; i < kOperationCount; ++i) {
+    counters.calls[i].store(0, std::memory_order_relaxed);
+    counters.flops[i].store(0, std::memory_order_relaxed);
+    for (auto &bucket : counters.latency[i]) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+void RecordAllocation(const size_t bytes) noexcept {
+  GetCounters().allocations.fetch_add(1, std::memory_order_relaxed);
+  GetCounters().bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void RecordOperation(const Operation operation, const double flops,
+                     const std::chrono::nanoseconds latency) noexcept {
+  if (!ValidOperation(operation)) {
+    return;
+  }
+  int bucket = 0;
+  for (auto ns = latency.count(); ns > 1 && bucket < kLatencyBuckets - 1;
+       ns >>= 1) {
+    ++bucket;
+  }
+  Counters &counters = GetCounters();
+  counters.calls[operation].fetch_add(1, std::memory_order_relaxed);
+  counters.flops[operation].fetch_add(static_cast<unsigned long long>(flops),
+                                      std::memory_order_relaxed);
+  counters.latency[operation][bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+}  // namespace stats
+}  // namespace s21
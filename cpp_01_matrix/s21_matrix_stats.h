@@ -0,0 +1,91 @@
+#ifndef CPP1_S21_MATRIXPLUS_4_S21_MATRIX_STATS_H_
+#define CPP1_S21_MATRIXPLUS_4_S21_MATRIX_STATS_H_
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+namespace s21 {
+namespace stats {
+
+enum Operation {
+  kSumMatrix,
+  kSubMatrix,
+  kMulNumber,
+  kMulMatrix,
+  kTranspose,
+  kDeterminant,
+  kCalcComplements,
+  kInverseMatrix,
+  kPower,
+  kExp,
+  kLU,
+  kMulVector,
+  kTriangularSolve,
+  kTriangularMul,
+  kGram,
+  kSymmetricMul,
+  kCholesky,
+  kSVD,
+  kBandMul,
+  kBandSolve,
+  kKronecker,
+  kHadamard,
+  kApply,
+  kOperationCount
+};
+
+// Bucket i of a latency histogram counts calls that took [2^i, 2^(i+1))
+// nanoseconds, the last bucket also holds everything slower.
+constexpr int kLatencyBuckets = 40;
+using Histogram = std::array<unsigned long long, kLatencyBuckets>;
+
+#ifdef S21_MATRIX_STATS
+constexpr bool kEnabled = true;
+#else
+constexpr bool kEnabled = false;
+#endif
+
+unsigned long long GetAllocations() noexcept;
+unsigned long long GetAllocatedBytes() noexcept;
+unsigned long long GetCalls(const Operation operation) noexcept;
+unsigned long long GetFlops(const Operation operation) noexcept;
+Histogram GetLatencyHistogram(const Operation operation) noexcept;
+void Reset() noexcept;
+
+void RecordAllocation(const size_t bytes) noexcept;
+void RecordOperation(const Operation operation, const double flops,
+                     const std::chrono::nanoseconds latency) noexcept;
+
+class ScopedOperation {
+ public:
+  ScopedOperation(const Operation operation, const double flops) noexcept
+      : operation_(operation),
+        flops_(flops),
+        start_(std::chrono::steady_clock::now()) {}
+  ScopedOperation(const ScopedOperation &) = delete;
+  void operator=(const ScopedOperation &) = delete;
+  ~ScopedOperation() {
+    RecordOperation(operation_, flops_,
+                    std::chrono::steady_clock::now() - start_);
+  }
+
+ private:
+  Operation operation_;
+  double flops_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace stats
+}  // namespace s21
+
+#ifdef S21_MATRIX_STATS
+#define S21_STATS_ALLOCATION(bytes) ::s21::stats::RecordAllocation(bytes)
+#define S21_STATS_OPERATION(operation, flops) \
+  ::s21::stats::ScopedOperation s21_stats_scope_(operation, flops)
+#else
+#define S21_STATS_ALLOCATION(bytes) static_cast<void>(0)
+#define S21_STATS_OPERATION(operation, flops) static_cast<void>(0)
+#endif
+
+#endif  // CPP1_S21_MATRIXPLUS_4_S21_MATRIX_STATS_H_
@@ -0,0 +1,141 @@
+#include "s21_numa.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <new>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "s21_parallel.h"
+
+namespace s21 {
+namespace numa {
+
+namespace {
+
+std::atomic<Placement> &CurrentPlacement() noexcept {
+  static std::atomic<Placement> placement{kLocal};
+  return placement;
+}
+
+// Online node ids from sysfs, the file holds a list such as "0-1,3".
+std::vector<int> ReadOnlineNodes() {
+  std::vector<int> nodes;
+  std::ifstream file("/sys/devices/system/node/online");
+  std::string range;
+  while (std::getline(file, range, ',')) {
+    const size_t dash = range.find('-');
+    try {
+      const int first = std::stoi(range.substr(0, dash));
+      const int last =
+          dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+      for (int node = first; node <= last; ++node) {
+        nodes.push_back(node);
+      }
+    } catch (...) {
+      return {};
+    }
+  }
+  return nodes;
+}
+
+const std::vector<int> &OnlineNodes() {
+  static const std::vector<int> nodes = ReadOnlineNodes();
+  return nodes;
+}
+
+#ifdef __linux__
+size_t MappedBytes(const size_t size) noexcept {
+  const size_t page = static_cast<size_t>(std::max(1L, sysconf(_SC_PAGESIZE)));
+  return (size * sizeof(double) + page - 1) / page * page;
+}
+
+// Sets MPOL_INTERLEAVE on a fresh mapping through the raw mbind syscall, so
+// libnuma is not needed. The policy goes away with the mapping.
+void Interleave(void *data, const size_t bytes) {
+  constexpr int kPolicyInterleave = 3;
+  constexpr int kBitsPerWord = 8 * sizeof(unsigned long);
+  const std::vector<int> &nodes = OnlineNodes();
+  if (nodes.size() < 2) {
+    return;
+  }
+  std::vector<unsigned long> node_mask(nodes.back() / kBitsPerWord + 1);
+  for (int node : nodes) {
+    node_mask[node / kBitsPerWord] |= 1UL << (node % kBitsPerWord);
+  }
+  syscall(SYS_mbind, data, bytes, kPolicyInterleave, node_mask.data(),
+          node_mask.size() * kBitsPerWord + 1, 0);
+}
+#endif
+
+}  // namespace
+
+Placement GetPlacement() noexcept { return CurrentPlacement().load(); }
+
+void SetPlacement(const Placement placement) noexcept {
+  CurrentPlacement().store(placement);
+}
+
+int NodeCount() noexcept {
+  return std::max(1, static_cast<int>(OnlineNodes().size()));
+}
+
+// Anonymous mappings are zero-filled by the kernel, kFirstTouch writes the
+// zeros again only to fault the pages in on the right threads.
+double *Allocate(const size_t size, const int row_size) {
+#ifdef __linux__
+  if (size < kPlacedSize) {
+    return new double[size]();
+  }
+  const size_t bytes = MappedBytes(size);
+  void *data = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (data == MAP_FAILED) {
+    throw std::bad_alloc();
+  }
+  double *values = static_cast<double *>(data);
+  const Placement placement = GetPlacement();
+  if (placement == kInterleave) {
+    Interleave(data, bytes);
+  }
+  if (placement != kFirstTouch) {
+    return values;
+  }
+  const size_t row = std::max(1, row_size);
+  const int rows = static_cast<int>((size + row - 1) / row);
+  const int grain = std::max(1, (1 << 14) / (row_size + 1));
+  try {
+    parallel::For(0, rows, grain, [&](const int first, const int last) {
+      std::fill(values + first * row, values + std::min(size, last * row),
+                0.0);
+    });
+  } catch (...) {
+    munmap(data, bytes);
+    throw;
+  }
+  return values;
+#else
+  static_cast<void>(row_size);
+  return new double[size]();
+#endif
+}
+
+void Deallocate(double *values, const size_t size) noexcept {
+#ifdef __linux__
+  if (size >= kPlacedSize) {
+    munmap(values, MappedBytes(size));
+    return;
+  }
+#endif
+  delete[] values;
+}
+
+}  // namespace numa
+}  // namespace s21
@@ -0,0 +1,33 @@
+#ifndef CPP1_S21_MATRIXPLUS_4_S21_NUMA_H_
+#define CPP1_S21_MATRIXPLUS_4_S21_NUMA_H_
+
+#include <cstddef>
+
+namespace s21 {
+namespace numa {
+
+// Where the pages of new S21Matrix buffers of at least kPlacedSize doubles
+// end up. Such buffers are fresh anonymous mappings, so none of their pages
+// has been touched yet. Linux places a page on the node of the thread that
+// touches it first, so kFirstTouch zeroes the rows with the same
+// parallel::For partition the row kernels use. kInterleave spreads the pages
+// round-robin over all online nodes, which suits buffers that are read by
+// every thread. kLocal leaves the pages to whichever thread writes first.
+// Smaller buffers come from new[] and are zeroed on the calling thread.
+enum Placement { kLocal, kFirstTouch, kInterleave };
+
+constexpr size_t kPlacedSize = size_t{1} << 19;
+
+Placement GetPlacement() noexcept;
+void SetPlacement(const Placement placement) noexcept;
+int NodeCount() noexcept;
+
+// Returns a zeroed buffer for size doubles laid out in rows of row_size
+// elements. Release it with Deallocate and the same size.
+double *Allocate(const size_t size, const int row_size);
+void Deallocate(double *values, const size_t size) noexcept;
+
+}  // namespace numa
+}  // namespace s21
+
+#endif  // CPP1_S21_MATRIXPLUS_4_S21_NUMA_H_
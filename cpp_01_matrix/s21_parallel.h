@@ -0,0 +1,196 @@
+#ifndef CPP1_S21_MATRIXPLUS_4_S21_PARALLEL_H_
+#define CPP1_S21_MATRIXPLUS_4_S21_PARALLEL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace s21 {
+namespace parallel {
+
+inline std::atomic<int> &ThreadLimit() noexcept {
+  static std::atomic<int> limit{
+      std::max(1, static_cast<int>(std::thread::hardware_concurrency()))};
+  return limit;
+}
+
+inline int ThreadCount() noexcept { return ThreadLimit().load(); }
+
+inline void SetThreadCount(const int count) noexcept {
+  ThreadLimit().store(
+      count > 0 ? count
+                : std::max(1, static_cast<int>(
+                                  std::thread::hardware_concurrency())));
+}
+
+namespace internal {
+
+// One For call split into chunks. Any thread may claim the next chunk, so
+// the caller never waits for a chunk that has not started yet and nested
+// For calls cannot deadlock. The first exception stops the remaining chunks.
+class Job {
+ public:
+  using Chunk = void (*)(void *context, int chunk);
+
+  Job(const int chunks, const Chunk chunk, void *context) noexcept
+      : chunks_(chunks), chunk_(chunk), context_(context) {}
+
+  bool RunNext() {
+    const int chunk = next_.fetch_add(1);
+    if (chunk >= chunks_) {
+      return false;
+    }
+    if (!failed_) {
+      try {
+        chunk_(context_, chunk);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex_);
+        if (!error_) {
+          error_ = std::current_exception();
+        }
+        failed_ = true;
+      }
+    }
+    return true;
+  }
+
+  void Rethrow() const {
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+  }
+
+  // Pool threads currently running chunks, guarded by the pool mutex.
+  int helpers{0};
+
+ private:
+  const int chunks_;
+  const Chunk chunk_;
+  void *const context_;
+  std::atomic<int> next_{0};
+  std::atomic<bool> failed_{false};
+  std::mutex error_mutex_;
+  std::exception_ptr error_;
+};
+
+// Threads started on first use and kept until exit. The pool grows to the
+// largest ThreadCount() - 1 requested so far.
+class Pool {
+ public:
+  static Pool &Instance() {
+    static Pool pool;
+    return pool;
+  }
+
+  ~Pool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    wakeup_.notify_all();
+    for (auto &thread : threads_) {
+      thread.join();
+    }
+  }
+
+  // Runs every chunk of job with the help of up to helpers pool threads and
+  // returns once all of them finished, rethrowing the first exception.
+  void Run(Job &job, const int helpers) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      while (static_cast<int>(threads_.size()) < helpers) {
+        threads_.emplace_back([this] { Work(); });
+      }
+      jobs_.push_back(&job);
+    }
+    wakeup_.notify_all();
+    while (job.RunNext()) {
+    }
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      Remove(&job);
+      released_.wait(lock, [&job] { return !job.helpers; });
+    }
+    job.Rethrow();
+  }
+
+ private:
+  Pool() = default;
+
+  void Work() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      wakeup_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+      if (stop_) {
+        return;
+      }
+      Job *job = jobs_.front();
+      ++job->helpers;
+      lock.unlock();
+      while (job->RunNext()) {
+      }
+      lock.lock();
+      Remove(job);
+      if (!--job->helpers) {
+        released_.notify_all();
+      }
+    }
+  }
+
+  void Remove(Job *job) noexcept {
+    const auto it = std::find(jobs_.begin(), jobs_.end(), job);
+    if (it != jobs_.end()) {
+      jobs_.erase(it);
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable wakeup_;
+  std::condition_variable released_;
+  std::vector<Job *> jobs_;
+  std::vector<std::thread> threads_;
+  bool stop_{false};
+};
+
+}  // namespace internal
+
+// Splits [begin, end) into at most ThreadCount() contiguous chunks of at least
+// `grain` items and calls function(first, last) for each chunk. The chunks
+// run on the calling thread and a persistent pool; the partition depends only
+// on the range, grain and ThreadCount(). The first exception thrown by
+// function is rethrown once every started chunk has finished.
+template <typename Function>
+void For(const int begin, const int end, const int grain, Function &&function) {
+  const int size = end - begin;
+  if (size <= 0) {
+    return;
+  }
+  const int chunks =
+      std::min(ThreadCount(), std::max(1, size / std::max(1, grain)));
+  if (chunks == 1) {
+    function(begin, end);
+    return;
+  }
+  const int step = size / chunks;
+  const int rest = size % chunks;
+  auto chunk = [&](const int index) {
+    const int first = begin + index * step + std::min(index, rest);
+    function(first, first + step + (index < rest));
+  };
+  internal::Job job(
+      chunks,
+      [](void *context, const int index) {
+        (*static_cast<decltype(chunk) *>(context))(index);
+      },
+      &chunk);
+  internal::Pool::Instance().Run(job, chunks - 1);
+}
+
+}  // namespace parallel
+}  // namespace s21
+
+#endif  // CPP1_S21_MATRIXPLUS_4_S21_PARALLEL_H_
@@ -0,0 +1,278 @@
+#include "s21_quantized_matrix.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define S21_QUANTIZED_X86 1
+#endif
+
+#include "s21_parallel.h"
+
+namespace s21 {
+
+namespace {
+
+// out[c] = sum over k < stride of lhs[k] * rhs[c * stride + k] for every
+// c < columns <= 4, stride is a multiple of 32. sums[c] is the sum of
+// column c, which the VNNI kernel needs to undo its unsigned offset.
+using DotKernel = void (*)(const int8_t *lhs, const int8_t *rhs,
+                           const int stride, const int columns,
+                           const int32_t *sums, int32_t *out);
+
+void DotGeneric(const int8_t *lhs, const int8_t *rhs, const int stride,
+                const int columns, const int32_t *, int32_t *out) {
+  for (int c = 0; c < columns; ++c) {
+    const int8_t *column = rhs + static_cast<size_t>(c) * stride;
+    int32_t sum = 0;
+    for (int k = 0; k < stride; ++k) {
+      sum += lhs[k] * column[k];
+    }
+    out[c] = sum;
+  }
+}
+
+#ifdef S21_QUANTIZED_X86
+__attribute__((target("avx2"))) int32_t HorizontalSum(const __m256i value) {
+  __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(value),
+                              _mm256_extracti128_si256(value, 1));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));
+  return _mm_cvtsi128_si32(sum);
+}
+
+// maddubs multiplies unsigned by signed bytes, so the sign of lhs moves to
+// rhs. Pairs of products stay below 2 * 127 * 127 and never saturate.
+__attribute__((target("avx2"))) void DotAVX2(const int8_t *lhs,
+                                             const int8_t *rhs,
+                                             const int stride,
+                                             const int columns,
+                                             const int32_t *, int32_t *out) {
+  const __m256i ones = _mm256_set1_epi16(1);
+  __m256i sums[4] = {_mm256_setzero_si256(), _mm256_setzero_si256(),
+                     _mm256_setzero_si256(), _mm256_setzero_si256()};
+  for (int k = 0; k < stride; k += 32) {
+    const __m256i a =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lhs + k));
+    const __m256i magnitude = _mm256_sign_epi8(a, a);
+    for (int c = 0; c < columns; ++c) {
+      const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(
+          rhs + static_cast<size_t>(c) * stride + k));
+      const __m256i pairs =
+          _mm256_maddubs_epi16(magnitude, _mm256_sign_epi8(b, a));
+      sums[c] = _mm256_add_epi32(sums[c], _mm256_madd_epi16(pairs, ones));
+    }
+  }
+  for (int c = 0; c < columns; ++c) {
+    out[c] = HorizontalSum(sums[c]);
+  }
+}
+
+// dpbusd adds four unsigned by signed byte products straight into int32.
+// lhs is shifted to lhs + 128 by flipping the sign bit, which adds
+// 128 * sums[c] to every dot product.
+__attribute__((target("avx2,avx512vl,avx512vnni"))) void DotAVX512VNNI(
+    const int8_t *lhs, const int8_t *rhs, const int stride, const int columns,
+    const int32_t *sums, int32_t *out) {
+  const __m256i flip = _mm256_set1_epi8(-128);
+  __m256i dots[4] = {_mm256_setzero_si256(), _mm256_setzero_si256(),
+                     _mm256_setzero_si256(), _mm256_setzero_si256()};
+  for (int k = 0; k < stride; k += 32) {
+    const __m256i a = _mm256_xor_si256(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lhs + k)), flip);
+    for (int c = 0; c < columns; ++c) {
+      const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(
+          rhs + static_cast<size_t>(c) * stride + k));
+      dots[c] = _mm256_dpbusd_epi32(dots[c], a, b);
+    }
+  }
+  for (int c = 0; c < columns; ++c) {
+    out[c] = HorizontalSum(dots[c]) - 128 * sums[c];
+  }
+}
+
+// Same as DotAVX512VNNI with the VEX encoded instruction of AVX-VNNI.
+__attribute__((target("avx2,avxvnni"))) void DotAVXVNNI(
+    const int8_t *lhs, const int8_t *rhs, const int stride, const int columns,
+    const int32_t *sums, int32_t *out) {
+  const __m256i flip = _mm256_set1_epi8(-128);
+  __m256i dots[4] = {_mm256_setzero_si256(), _mm256_setzero_si256(),
+                     _mm256_setzero_si256(), _mm256_setzero_si256()};
+  for (int k = 0; k < stride; k += 32) {
+    const __m256i a = _mm256_xor_si256(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lhs + k)), flip);
+    for (int c = 0; c < columns; ++c) {
+      const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(
+          rhs + static_cast<size_t>(c) * stride + k));
+      dots[c] = _mm256_dpbusd_avx_epi32(dots[c], a, b);
+    }
+  }
+  for (int c = 0; c < columns; ++c) {
+    out[c] = HorizontalSum(dots[c]) - 128 * sums[c];
+  }
+}
+#endif
+
+DotKernel FindKernel(const S21QuantizedMatrix::Kernel kernel) noexcept {
+#ifdef S21_QUANTIZED_X86
+  if (kernel == S21QuantizedMatrix::kVNNI) {
+    return __builtin_cpu_supports("avx512vnni") &&
+                   __builtin_cpu_supports("avx512vl")
+               ? DotAVX512VNNI
+               : DotAVXVNNI;
+  }
+  if (kernel == S21QuantizedMatrix::kAVX2) {
+    return DotAVX2;
+  }
+#else
+  static_cast<void>(kernel);
+#endif
+  return DotGeneric;
+}
+
+std::atomic<S21QuantizedMatrix::Kernel> &CurrentKernel() noexcept {
+  static std::atomic<S21QuantizedMatrix::Kernel> kernel{
+      S21QuantizedMatrix::SupportedKernel()};
+  return kernel;
+}
+
+}  // namespace
+
+S21QuantizedMatrix::S21QuantizedMatrix(const S21Matrix &matrix,
+                                       const Axis axis)
+    : rows_(matrix.get_rows()), cols_(matrix.get_cols()), axis_(axis) {
+  const int groups = Groups();
+  const int size = GroupSize();
+  stride_ = (size + kAlignment - 1) / kAlignment * kAlignment;
+  values_.assign(static_cast<size_t>(groups) * stride_, 0);
+  scales_.assign(groups, 0.0);
+  sums_.assign(groups, 0);
+  const int grain = std::max(1, (1 << 14) / (size + 1));
+  parallel::For(0, groups, grain, [&](const int first, const int last) {
+    for (int g = first; g < last; ++g) {
+      auto element = [&](const int k) {
+        return axis_ == kPerRow ? matrix[g][k] : matrix[k][g];
+      };
+      double magnitude = 0.0;
+      for (int k = 0; k < size; ++k) {
+        magnitude = std::max(magnitude, fabs(element(k)));
+      }
+      if (magnitude == 0.0) {
+        continue;
+      }
+      scales_[g] = magnitude / 127;
+      const double inverse = 127 / magnitude;
+      int8_t *values = values_.data() + static_cast<size_t>(g) * stride_;
+      for (int k = 0; k < size; ++k) {
+        values[k] = static_cast<int8_t>(
+            std::clamp(nearbyint(element(k) * inverse), -127.0, 127.0));
+        sums_[g] += values[k];
+      }
+    }
+  });
+}
+
+int S21QuantizedMatrix::get_rows() const noexcept { return rows_; }
+
+int S21QuantizedMatrix::get_cols() const noexcept { return cols_; }
+
+S21QuantizedMatrix::Axis S21QuantizedMatrix::get_axis() const noexcept {
+  return axis_;
+}
+
+const std::vector<double> &S21QuantizedMatrix::get_scales() const noexcept {
+  return scales_;
+}
+
+double S21QuantizedMatrix::operator()(const int row, const int col) const {
+  if (row < 1 || col < 1 || row > rows_ || col > cols_) {
+    throw std::logic_error("(): element doesn't exist");
+  }
+  const int group = axis_ == kPerRow ? row - 1 : col - 1;
+  const int index = axis_ == kPerRow ? col - 1 : row - 1;
+  return scales_[group] *
+         values_[static_cast<size_t>(group) * stride_ + index];
+}
+
+S21Matrix S21QuantizedMatrix::ToMatrix() const {
+  S21Matrix result(rows_, cols_);
+  for (int i = 0; i < rows_; ++i) {
+    for (int j = 0; j < cols_; ++j) {
+      result[i][j] = (*this)(i + 1, j + 1);
+    }
+  }
+  return result;
+}
+
+// Columns of other go in blocks of kBlock, so the block stays in cache while
+// every row of this thread's range is multiplied by it.
+S21Matrix S21QuantizedMatrix::operator*(
+    const S21QuantizedMatrix &other) const {
+  if (axis_ != kPerRow || other.axis_ != kPerColumn) {
+    throw std::logic_error(
+        "QuantizedMatrix: lhs must be quantized per row and rhs per column");
+  }
+  if (cols_ != other.rows_) {
+    throw std::logic_error("QuantizedMatrix: M1(cols) != M2(rows)");
+  }
+  S21Matrix result(rows_, other.cols_);
+  const DotKernel dot = FindKernel(GetKernel());
+  const long work = static_cast<long>(stride_) * other.cols_;
+  const int grain = static_cast<int>(std::max(1L, (1L << 16) / (work + 1)));
+  parallel::For(0, rows_, grain, [&](const int first, const int last) {
+    int32_t dots[4];
+    for (int block = 0; block < other.cols_; block += kBlock) {
+      const int block_end = std::min(other.cols_, block + kBlock);
+      for (int i = first; i < last; ++i) {
+        const int8_t *lhs = values_.data() + static_cast<size_t>(i) * stride_;
+        double *row = result[i];
+        for (int j = block; j < block_end; j += 4) {
+          const int columns = std::min(4, block_end - j);
+          dot(lhs, other.values_.data() + static_cast<size_t>(j) * stride_,
+              stride_, columns, other.sums_.data() + j, dots);
+          for (int c = 0; c < columns; ++c) {
+            row[j + c] = scales_[i] * other.scales_[j + c] * dots[c];
+          }
+        }
+      }
+    }
+  });
+  return result;
+}
+
+S21QuantizedMatrix::Kernel S21QuantizedMatrix::SupportedKernel() noexcept {
+#ifdef S21_QUANTIZED_X86
+  if ((__builtin_cpu_supports("avx512vnni") &&
+       __builtin_cpu_supports("avx512vl")) ||
+      __builtin_cpu_supports("avxvnni")) {
+    return kVNNI;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return kAVX2;
+  }
+#endif
+  return kGeneric;
+}
+
+S21QuantizedMatrix::Kernel S21QuantizedMatrix::GetKernel() noexcept {
+  return CurrentKernel().load();
+}
+
+// Kernels the CPU lacks fall back to the fastest supported one.
+void S21QuantizedMatrix::SetKernel(const Kernel kernel) noexcept {
+  CurrentKernel().store(std::min(kernel, SupportedKernel()));
+}
+
+int S21QuantizedMatrix::Groups() const noexcept {
+  return axis_ == kPerRow ? rows_ : cols_;
+}
+
+int S21QuantizedMatrix::GroupSize() const noexcept {
+  return axis_ == kPerRow ? cols_ : rows_;
+}
+
+}  // namespace s21
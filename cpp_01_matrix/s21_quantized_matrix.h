@@ -0,0 +1,54 @@
+#ifndef CPP1_S21_MATRIXPLUS_4_S21_QUANTIZED_MATRIX_H_
+#define CPP1_S21_MATRIXPLUS_4_S21_QUANTIZED_MATRIX_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+namespace s21 {
+
+// Symmetric int8 quantization with one scale factor per row or per column:
+// x ~ scale * q with q in [-127, 127]. Every row (kPerRow) or column
+// (kPerColumn) is stored contiguously and zero-padded to kAlignment bytes.
+// The product of a kPerRow and a kPerColumn matrix accumulates int8 dot
+// products in int32, which is exact for inner sizes below 133000, and
+// applies both scales once per output element.
+class S21QuantizedMatrix {
+ public:
+  enum Axis { kPerRow, kPerColumn };
+  // Dot product kernels in increasing speed, the fastest one the CPU
+  // supports is used unless SetKernel asks for a slower one.
+  enum Kernel { kGeneric, kAVX2, kVNNI };
+
+  S21QuantizedMatrix() = default;
+  explicit S21QuantizedMatrix(const S21Matrix &matrix,
+                              const Axis axis = kPerRow);
+  int get_rows() const noexcept;
+  int get_cols() const noexcept;
+  Axis get_axis() const noexcept;
+  const std::vector<double> &get_scales() const noexcept;
+  double operator()(const int row, const int col) const;
+  S21Matrix ToMatrix() const;
+  S21Matrix operator*(const S21QuantizedMatrix &other) const;
+  static Kernel SupportedKernel() noexcept;
+  static Kernel GetKernel() noexcept;
+  static void SetKernel(const Kernel kernel) noexcept;
+
+ private:
+  static constexpr int kAlignment = 32;
+  static constexpr int kBlock = 64;
+  int Groups() const noexcept;
+  int GroupSize() const noexcept;
+  int rows_{0};
+  int cols_{0};
+  int stride_{0};
+  Axis axis_{kPerRow};
+  std::vector<int8_t> values_;
+  std::vector<double> scales_;
+  std::vector<int32_t> sums_;
+};
+
+}  // namespace s21
+
+#endif  // CPP1_S21_MATRIXPLUS_4_S21_QUANTIZED_MATRIX_H_
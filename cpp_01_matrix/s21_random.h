@@ -0,0 +1,70 @@
+#ifndef CPP1_S21_MATRIXPLUS_4_S21_RANDOM_H_
+#define CPP1_S21_MATRIXPLUS_4_S21_RANDOM_H_
+
+#include <cstdint>
+
+#include "s21_simd.h"
+
+namespace s21 {
+namespace random {
+
+// Philox4x32-10 counter-based generator (Salmon et al., "Parallel random
+// numbers: as easy as 1, 2, 3"). The output block is a pure function of the
+// counter and the key, so any element can be generated independently of the
+// others. Lanes hold one 32-bit word in 64 bits, which lets T be a scalar
+// or a GCC vector of uint64_t that computes several blocks at once.
+constexpr uint64_t kMultiplier0 = 0xD2511F53;
+constexpr uint64_t kMultiplier1 = 0xCD9E8D57;
+constexpr uint64_t kWeyl0 = 0x9E3779B9;
+constexpr uint64_t kWeyl1 = 0xBB67AE85;
+constexpr uint64_t kWordMask = 0xFFFFFFFF;
+
+constexpr uint64_t Multiply(const uint64_t lhs, const uint64_t rhs) noexcept {
+  return lhs * rhs;
+}
+
+inline simd::Uint2 Multiply(const simd::Uint2 lhs,
+                            const uint64_t rhs) noexcept {
+  return simd::MulLow32(lhs, rhs);
+}
+
+template <typename T>
+struct Block {
+  T words[4];
+};
+
+template <typename T>
+constexpr Block<T> Philox(Block<T> block, uint64_t key_0,
+                          uint64_t key_1) noexcept {
+  for (int round = 0; round < 10; ++round) {
+    const T product_0 = Multiply(block.words[0], kMultiplier0);
+    const T product_1 = Multiply(block.words[2], kMultiplier1);
+    block = Block<T>{{(product_1 >> 32) ^ block.words[1] ^ key_0,
+                      product_1 & kWordMask,
+                      (product_0 >> 32) ^ block.words[3] ^ key_1,
+                      product_0 & kWordMask}};
+    key_0 = (key_0 + kWeyl0) & kWordMask;
+    key_1 = (key_1 + kWeyl1) & kWordMask;
+  }
+  return block;
+}
+
+// Block number index of the stream selected by seed.
+template <typename T>
+constexpr Block<T> Generate(const T index, const uint64_t seed) noexcept {
+  return Philox(Block<T>{{index & kWordMask, index >> 32, T{}, T{}}},
+                seed & kWordMask, seed >> 32);
+}
+
+// 53 random bits from two words, scaled to [0, 1) by the caller.
+template <typename T>
+constexpr T Mantissa(const T high, const T low) noexcept {
+  return (high << 21) ^ (low >> 11);
+}
+
+constexpr double kMantissaScale = 1.0 / 9007199254740992.0;
+
+}  // namespace random
+}  // namespace s21
+
+#endif  // CPP1_S21_MATRIXPLUS_4_S21_RANDOM_H_
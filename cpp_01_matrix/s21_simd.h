@@ -0,0 +1,156 @@
+#ifndef CPP1_S21_MATRIXPLUS_4_S21_SIMD_H_
+#define CPP1_S21_MATRIXPLUS_4_S21_SIMD_H_
+
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace s21 {
+namespace simd {
+
+// Two-lane vectors built on the GCC/Clang vector extension. 16 bytes keeps
+// the ABI stable on every x86-64 and AArch64 target without extra flags.
+typedef double Double2 __attribute__((vector_size(16)));
+typedef long long Mask2 __attribute__((vector_size(16)));
+typedef unsigned long long Uint2 __attribute__((vector_size(16)));
+
+constexpr int kWidth = 2;
+
+inline Double2 Load(const double *source) noexcept {
+  Double2 result;
+  memcpy(&result, source, sizeof(result));
+  return result;
+}
+
+inline void Store(double *destination, const Double2 value) noexcept {
+  memcpy(destination, &value, sizeof(value));
+}
+
+inline Double2 Broadcast(const double value) noexcept {
+  return Double2{value, value};
+}
+
+template <typename T>
+inline T LoadAs(const double *source) noexcept;
+
+template <>
+inline double LoadAs<double>(const double *source) noexcept {
+  return *source;
+}
+
+template <>
+inline Double2 LoadAs<Double2>(const double *source) noexcept {
+  return Load(source);
+}
+
+inline double Abs(const double value) noexcept {
+  return value < 0 ? -value : value;
+}
+
+inline Double2 Abs(const Double2 value) noexcept {
+  return reinterpret_cast<Double2>(reinterpret_cast<Mask2>(value) &
+                                   0x7fffffffffffffffLL);
+}
+
+inline Double2 Max(const Double2 lhs, const Double2 rhs) noexcept {
+  return lhs > rhs ? lhs : rhs;
+}
+
+inline Double2 Min(const Double2 lhs, const Double2 rhs) noexcept {
+  return lhs < rhs ? lhs : rhs;
+}
+
+inline bool Any(const Mask2 mask) noexcept { return mask[0] | mask[1]; }
+
+inline double Sum(const Double2 value) noexcept { return value[0] + value[1]; }
+
+// 64-bit products of the low 32 bits of every lane, a single pmuludq on x86
+// where the generic vector multiply needs three.
+inline Uint2 MulLow32(const Uint2 lhs, const unsigned long long rhs) noexcept {
+#ifdef __SSE2__
+  return reinterpret_cast<Uint2>(_mm_mul_epu32(
+      reinterpret_cast<__m128i>(lhs), _mm_set1_epi64x(rhs)));
+#else
+  return (lhs & 0xFFFFFFFFULL) * (rhs & 0xFFFFFFFFULL);
+#endif
+}
+
+// e^r - 1 for |r| <= ln(2) / 2 from the Cephes rational approximation
+// e^r = 1 + 2 r P(r^2) / (Q(r^2) - r P(r^2)).
+inline Double2 Expm1Reduced(const Double2 r) noexcept {
+  const Double2 square = r * r;
+  const Double2 p =
+      r * ((1.26177193074810590878e-4 * square + 3.02994407707441961300e-2) *
+               square +
+           9.99999999999999999910e-1);
+  const Double2 q = ((3.00198505138664455042e-6 * square +
+                      2.52448340349684104192e-3) *
+                         square +
+                     2.27265548208155028766e-1) *
+                        square +
+                    2.00000000000000000009e0;
+  return 2.0 * p / (q - p);
+}
+
+// e^x = 2^n * e^r with x = n ln(2) + r. The power of two is applied as two
+// halves, so overflow to infinity and gradual underflow come out right.
+inline Double2 Exp(const Double2 x) noexcept {
+  constexpr double kLog2E = 1.4426950408889634;
+  constexpr double kLn2High = 0.693147180369123816490;
+  constexpr double kLn2Low = 1.90821492927058770002e-10;
+  constexpr double kRound = 6755399441055744.0;
+  const Double2 clamped = Min(Max(x, Broadcast(-746.0)), Broadcast(710.0));
+  const Double2 n = (clamped * kLog2E + kRound) - kRound;
+  const Double2 r = (clamped - n * kLn2High) - n * kLn2Low;
+  const Mask2 exponent = __builtin_convertvector(n, Mask2);
+  const Mask2 half = exponent >> 1;
+  const Double2 scale_1 = reinterpret_cast<Double2>((half + 1023) << 52);
+  const Double2 scale_2 =
+      reinterpret_cast<Double2>((exponent - half + 1023) << 52);
+  const Double2 result = (Expm1Reduced(r) + 1.0) * scale_1 * scale_2;
+  return x == x ? result : x;
+}
+
+// tanh(x) = (1 - e^(-2|x|)) / (1 + e^(-2|x|)) with the sign of x, near zero
+// the numerator comes from the series to keep the relative error small.
+inline Double2 Tanh(const Double2 x) noexcept {
+  const Mask2 sign =
+      reinterpret_cast<Mask2>(x) & static_cast<long long>(0x8000000000000000ULL);
+  const Double2 magnitude = Abs(x);
+  const Double2 small = Expm1Reduced(Min(magnitude, Broadcast(0.17)) * -2.0);
+  const Double2 e = Exp(magnitude * -2.0);
+  const Double2 numerator = magnitude < 0.17 ? -small : 1.0 - e;
+  const Double2 denominator = magnitude < 0.17 ? small + 2.0 : 1.0 + e;
+  const Double2 result = numerator / denominator;
+  return reinterpret_cast<Double2>(reinterpret_cast<Mask2>(result) | sign);
+}
+
+// Element-wise functions for S21Matrix::Apply, the scalar overloads go
+// through the same kernels so every element is rounded the same way.
+struct ExpFunction {
+  double operator()(const double x) const noexcept {
+    return Exp(Broadcast(x))[0];
+  }
+  Double2 operator()(const Double2 x) const noexcept { return Exp(x); }
+};
+
+struct TanhFunction {
+  double operator()(const double x) const noexcept {
+    return Tanh(Broadcast(x))[0];
+  }
+  Double2 operator()(const Double2 x) const noexcept { return Tanh(x); }
+};
+
+struct ReluFunction {
+  double operator()(const double x) const noexcept { return x > 0 ? x : 0.0; }
+  Double2 operator()(const Double2 x) const noexcept {
+    return x > 0 ? x : Broadcast(0.0);
+  }
+};
+
+}  // namespace simd
+}  // namespace s21
+
+#endif  // CPP1_S21_MATRIXPLUS_4_S21_SIMD_H_
@@ -0,0 +1,136 @@
+#ifndef CPP1_S21_MATRIXPLUS_4_S21_SMALL_MATRIX_H_
+#define CPP1_S21_MATRIXPLUS_4_S21_SMALL_MATRIX_H_
+
+#include <array>
+#include <stdexcept>
+
+namespace s21 {
+namespace small {
+
+// Closed-form determinant, cofactor and inverse kernels for row-major
+// matrices of size 1..4. Everything is constexpr, so a constant matrix can be
+// inverted at compile time.
+template <int N>
+using Square = std::array<double, N * N>;
+
+template <int N>
+constexpr Square<N> Load(const double *data) noexcept {
+  Square<N> result{};
+  for (int i = 0; i < N * N; ++i) {
+    result[i] = data[i];
+  }
+  return result;
+}
+
+template <int N>
+constexpr Square<N> Transpose(const Square<N> &m) noexcept {
+  Square<N> result{};
+  for (int i = 0; i < N; ++i) {
+    for (int j = 0; j < N; ++j) {
+      result[j * N + i] = m[i * N + j];
+    }
+  }
+  return result;
+}
+
+template <int N>
+constexpr double Determinant(const Square<N> &m) noexcept {
+  static_assert(N >= 1 && N <= 4, "closed forms exist for sizes 1..4");
+  if constexpr (N == 1) {
+    return m[0];
+  } else if constexpr (N == 2) {
+    return m[0] * m[3] - m[1] * m[2];
+  } else if constexpr (N == 3) {
+    return m[0] * (m[4] * m[8] - m[5] * m[7]) -
+           m[1] * (m[3] * m[8] - m[5] * m[6]) +
+           m[2] * (m[3] * m[7] - m[4] * m[6]);
+  } else {
+    const double s0 = m[0] * m[5] - m[4] * m[1];
+    const double s1 = m[0] * m[6] - m[4] * m[2];
+    const double s2 = m[0] * m[7] - m[4] * m[3];
+    const double s3 = m[1] * m[6] - m[5] * m[2];
+    const double s4 = m[1] * m[7] - m[5] * m[3];
+    const double s5 = m[2] * m[7] - m[6] * m[3];
+    const double c0 = m[8] * m[13] - m[12] * m[9];
+    const double c1 = m[8] * m[14] - m[12] * m[10];
+    const double c2 = m[8] * m[15] - m[12] * m[11];
+    const double c3 = m[9] * m[14] - m[13] * m[10];
+    const double c4 = m[9] * m[15] - m[13] * m[11];
+    const double c5 = m[10] * m[15] - m[14] * m[11];
+    return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+  }
+}
+
+// Transposed cofactor matrix, inverse = Adjugate(m) / Determinant(m).
+template <int N>
+constexpr Square<N> Adjugate(const Square<N> &m) noexcept {
+  static_assert(N >= 2 && N <= 4, "closed forms exist for sizes 2..4");
+  if constexpr (N == 2) {
+    return {m[3], -m[1], -m[2], m[0]};
+  } else if constexpr (N == 3) {
+    return {m[4] * m[8] - m[5] * m[7], m[2] * m[7] - m[1] * m[8],
+            m[1] * m[5] - m[2] * m[4], m[5] * m[6] - m[3] * m[8],
+            m[0] * m[8] - m[2] * m[6], m[2] * m[3] - m[0] * m[5],
+            m[3] * m[7] - m[4] * m[6], m[1] * m[6] - m[0] * m[7],
+            m[0] * m[4] - m[1] * m[3]};
+  } else {
+    const double s0 = m[0] * m[5] - m[4] * m[1];
+    const double s1 = m[0] * m[6] - m[4] * m[2];
+    const double s2 = m[0] * m[7] - m[4] * m[3];
+    const double s3 = m[1] * m[6] - m[5] * m[2];
+    const double s4 = m[1] * m[7] - m[5] * m[3];
+    const double s5 = m[2] * m[7] - m[6] * m[3];
+    const double c0 = m[8] * m[13] - m[12] * m[9];
+    const double c1 = m[8] * m[14] - m[12] * m[10];
+    const double c2 = m[8] * m[15] - m[12] * m[11];
+    const double c3 = m[9] * m[14] - m[13] * m[10];
+    const double c4 = m[9] * m[15] - m[13] * m[11];
+    const double c5 = m[10] * m[15] - m[14] * m[11];
+    return {m[5] * c5 - m[6] * c4 + m[7] * c3,
+            -m[1] * c5 + m[2] * c4 - m[3] * c3,
+            m[13] * s5 - m[14] * s4 + m[15] * s3,
+            -m[9] * s5 + m[10] * s4 - m[11] * s3,
+            -m[4] * c5 + m[6] * c2 - m[7] * c1,
+            m[0] * c5 - m[2] * c2 + m[3] * c1,
+            -m[12] * s5 + m[14] * s2 - m[15] * s1,
+            m[8] * s5 - m[10] * s2 + m[11] * s1,
+            m[4] * c4 - m[5] * c2 + m[7] * c0,
+            -m[0] * c4 + m[1] * c2 - m[3] * c0,
+            m[12] * s4 - m[13] * s2 + m[15] * s0,
+            -m[8] * s4 + m[9] * s2 - m[11] * s0,
+            -m[4] * c3 + m[5] * c1 - m[6] * c0,
+            m[0] * c3 - m[1] * c1 + m[2] * c0,
+            -m[12] * s3 + m[13] * s1 - m[14] * s0,
+            m[8] * s3 - m[9] * s1 + m[10] * s0};
+  }
+}
+
+template <int N>
+constexpr Square<N> Complements(const Square<N> &m) noexcept {
+  return Transpose<N>(Adjugate<N>(m));
+}
+
+template <int N>
+constexpr Square<N> Inverse(const Square<N> &m) {
+  const double determinant = Determinant<N>(m);
+  if (!determinant) {
+    throw std::logic_error("Determinant is zero");
+  }
+  Square<N> result = Adjugate<N>(m);
+  const double scale = 1 / determinant;
+  for (int i = 0; i < N * N; ++i) {
+    result[i] *= scale;
+  }
+  return result;
+}
+
+// Floating point operations performed by Determinant<N>, indexed by N.
+constexpr double kDeterminantFlops[] = {0, 0, 3, 14, 47};
+
+// Floating point operations performed by Adjugate<N>, indexed by N.
+constexpr double kAdjugateFlops[] = {0, 0, 0, 27, 116};
+
+}  // namespace small
+}  // namespace s21
+
+#endif  // CPP1_S21_MATRIXPLUS_4_S21_SMALL_MATRIX_H_
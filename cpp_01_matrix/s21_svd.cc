@@ -0,0 +1,466 @@
+#include "s21_svd.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+#include "s21_matrix_stats.h"
+#include "s21_parallel.h"
+#include "s21_symmetric_matrix.h"
+
+namespace s21 {
+
+namespace {
+
+std::vector<double*> RowPointers(S21Matrix& matrix) {
+  std::vector<double*> result(matrix.get_rows());
+  for (int i = 0; i < matrix.get_rows(); ++i) {
+    result[i] = matrix[i];
+  }
+  return result;
+}
+
+// Applies the Householder reflection stored in column col, rows
+// [row_first, row_last), to columns [col_first, col_last). The rows are
+// streamed in order and the columns are split between threads.
+void ApplyReflector(const std::vector<double*>& rows, const int row_first,
+                    const int row_last, const int col, const int col_first,
+                    const int col_last) {
+  const long work = static_cast<long>(row_last - row_first) * 2;
+  const int grain = static_cast<int>(std::max(1L, (1L << 16) / (work + 1)));
+  const double pivot = rows[row_first][col];
+  parallel::For(col_first, col_last, grain, [&](const int first,
+                                                const int last) {
+    std::vector<double> factors(last - first, 0.0);
+    for (int i = row_first; i < row_last; ++i) {
+      const double value = rows[i][col];
+      const double* row = rows[i] + first;
+      for (int j = 0; j < last - first; ++j) {
+        factors[j] += value * row[j];
+      }
+    }
+    for (double& factor : factors) {
+      factor = -factor / pivot;
+    }
+    for (int i = row_first; i < row_last; ++i) {
+      const double value = rows[i][col];
+      double* row = rows[i] + first;
+      for (int j = 0; j < last - first; ++j) {
+        row[j] += factors[j] * value;
+      }
+    }
+  });
+}
+
+// Plane rotation of columns first and second of every row.
+void RotateColumns(const std::vector<double*>& rows, const int first,
+                   const int second, const double cs, const double sn) {
+  for (double* row : rows) {
+    const double value = cs * row[first] + sn * row[second];
+    row[second] = -sn * row[first] + cs * row[second];
+    row[first] = value;
+  }
+}
+
+void SwapColumns(const std::vector<double*>& rows, const int first,
+                 const int second) {
+  for (double* row : rows) {
+    std::swap(row[first], row[second]);
+  }
+}
+
+// Fallback for a rank deficient basis: modified Gram-Schmidt applied twice,
+// rows that are dependent on the previous ones become zero.
+void GramSchmidtRows(S21Matrix& rows) {
+  const int count = rows.get_rows();
+  const int size = rows.get_cols();
+  for (int i = 0; i < count; ++i) {
+    double* row = rows[i];
+    const double norm = sqrt(std::inner_product(row, row + size, row, 0.0));
+    for (int pass = 0; pass < 2; ++pass) {
+      for (int k = 0; k < i; ++k) {
+        const double* other = rows[k];
+        const double dot = std::inner_product(row, row + size, other, 0.0);
+        for (int j = 0; j < size; ++j) {
+          row[j] -= dot * other[j];
+        }
+      }
+    }
+    const double rest = sqrt(std::inner_product(row, row + size, row, 0.0));
+    const double scale = rest > 1e-10 * norm ? 1.0 / rest : 0.0;
+    for (int j = 0; j < size; ++j) {
+      row[j] *= scale;
+    }
+  }
+}
+
+// Makes the rows of a short wide matrix orthonormal with CholeskyQR2: the
+// Gram matrix, its Cholesky factor and a triangular solve, twice. All three
+// steps are multithreaded GEMM-like kernels.
+void OrthonormalizeRows(S21Matrix& rows) {
+  try {
+    for (int pass = 0; pass < 2; ++pass) {
+      S21SymmetricMatrix::Gram(rows, true).Cholesky().Solve(rows.data(),
+                                                             rows.get_cols());
+    }
+  } catch (const std::logic_error&) {
+    GramSchmidtRows(rows);
+  }
+}
+
+void CheckFinite(const S21Matrix& matrix) {
+  if (!std::all_of(matrix.begin(), matrix.end(),
+                   [](const double value) { return std::isfinite(value); })) {
+    throw std::logic_error("SVD: matrix has non-finite elements");
+  }
+}
+
+S21Matrix GaussianMatrix(const int rows, const int cols,
+                         const unsigned long seed) {
+  S21Matrix result(rows, cols);
+  result.FillRandom(seed, S21Matrix::kNormal);
+  return result;
+}
+
+}  // namespace
+
+S21SVD::S21SVD(const S21Matrix& matrix) {
+  if (!matrix.get_rows()) {
+    throw std::logic_error("SVD: operation with NULL matrix");
+  }
+  CheckFinite(matrix);
+  const bool wide = matrix.get_rows() < matrix.get_cols();
+  S21Matrix work = wide ? matrix.Transpose() : matrix;
+  work.set_copy_on_write(false);
+  Decompose(work);
+  if (wide) {
+    std::swap(u_, v_);
+  }
+}
+
+// Halko-Martinsson-Tropp range finder: Q spans A * Omega after the power
+// iterations, B = Q^T * A is decomposed exactly and U = Q * U_B. Everything
+// except the small decomposition is a multithreaded GEMM.
+S21SVD S21SVD::Randomized(const S21Matrix& matrix, const int rank,
+                          const int oversampling, const int power_iterations,
+                          const unsigned long seed) {
+  const int rows = matrix.get_rows();
+  const int cols = matrix.get_cols();
+  if (!rows) {
+    throw std::logic_error("SVD: operation with NULL matrix");
+  }
+  if (rank < 1 || rank > std::min(rows, cols) || oversampling < 0 ||
+      power_iterations < 0) {
+    throw std::logic_error("SVD: invalid rank");
+  }
+  CheckFinite(matrix);
+  const int sketch = std::min(std::min(rows, cols), rank + oversampling);
+  S21Matrix basis = (matrix * GaussianMatrix(cols, sketch, seed)).Transpose();
+  OrthonormalizeRows(basis);
+  for (int i = 0; i < power_iterations; ++i) {
+    S21Matrix projection = basis * matrix;
+    OrthonormalizeRows(projection);
+    basis = (matrix * projection.Transpose()).Transpose();
+    OrthonormalizeRows(basis);
+  }
+  S21SVD small(basis * matrix);
+  S21SVD result;
+  result.u_ = basis.Transpose() * small.u_;
+  result.values_ = std::move(small.values_);
+  result.v_ = std::move(small.v_);
+  result.Truncate(rank);
+  return result;
+}
+
+const S21Matrix& S21SVD::get_u() const noexcept { return u_; }
+
+const std::vector<double>& S21SVD::get_singular_values() const noexcept {
+  return values_;
+}
+
+const S21Matrix& S21SVD::get_v() const noexcept { return v_; }
+
+S21Matrix S21SVD::Reconstruct() const {
+  S21Matrix scaled{u_};
+  for (int i = 0; i < scaled.get_rows(); ++i) {
+    double* row = scaled[i];
+    for (size_t j = 0; j < values_.size(); ++j) {
+      row[j] *= values_[j];
+    }
+  }
+  return scaled * v_.Transpose();
+}
+
+// Householder bidiagonalization of a matrix with rows >= cols, the
+// reflections are accumulated into u_ (rows x cols) and v_ (cols x cols).
+void S21SVD::Decompose(S21Matrix& matrix) {
+  const int m = matrix.get_rows();
+  const int n = matrix.get_cols();
+  S21_STATS_OPERATION(stats::kSVD, 4.0 * m * n * n + 8.0 * n * n * n);
+  u_ = S21Matrix(m, n);
+  v_ = S21Matrix(n, n);
+  u_.set_copy_on_write(false);
+  v_.set_copy_on_write(false);
+  values_.assign(n, 0.0);
+  std::vector<double>& s = values_;
+  std::vector<double> e(n, 0.0);
+  const std::vector<double*> a = RowPointers(matrix);
+  const std::vector<double*> u = RowPointers(u_);
+  const std::vector<double*> v = RowPointers(v_);
+  const int nct = std::min(m - 1, n);
+  const int nrt = std::max(0, std::min(n - 2, m));
+  for (int k = 0; k < std::max(nct, nrt); ++k) {
+    if (k < nct) {
+      s[k] = 0.0;
+      for (int i = k; i < m; ++i) {
+        s[k] = hypot(s[k], a[i][k]);
+      }
+      if (s[k]) {
+        if (a[k][k] < 0.0) {
+          s[k] = -s[k];
+        }
+        for (int i = k; i < m; ++i) {
+          a[i][k] /= s[k];
+        }
+        a[k][k] += 1.0;
+        ApplyReflector(a, k, m, k, k + 1, n);
+      }
+      s[k] = -s[k];
+    }
+    for (int j = k + 1; j < n; ++j) {
+      e[j] = a[k][j];
+    }
+    if (k < nct) {
+      for (int i = k; i < m; ++i) {
+        u[i][k] = a[i][k];
+      }
+    }
+    if (k < nrt) {
+      e[k] = 0.0;
+      for (int i = k + 1; i < n; ++i) {
+        e[k] = hypot(e[k], e[i]);
+      }
+      if (e[k]) {
+        if (e[k + 1] < 0.0) {
+          e[k] = -e[k];
+        }
+        for (int i = k + 1; i < n; ++i) {
+          e[i] /= e[k];
+        }
+        e[k + 1] += 1.0;
+      }
+      e[k] = -e[k];
+      if (k + 1 < m && e[k]) {
+        const long cost = 2L * (n - k);
+        const int grain = static_cast<int>(std::max(1L, (1L << 16) / cost));
+        parallel::For(k + 1, m, grain, [&](const int first, const int last) {
+          for (int i = first; i < last; ++i) {
+            double* row = a[i];
+            double sum = 0.0;
+            for (int j = k + 1; j < n; ++j) {
+              sum += e[j] * row[j];
+            }
+            for (int j = k + 1; j < n; ++j) {
+              row[j] -= e[j] / e[k + 1] * sum;
+            }
+          }
+        });
+      }
+      for (int i = k + 1; i < n; ++i) {
+        v[i][k] = e[i];
+      }
+    }
+  }
+  if (nct < n) {
+    s[nct] = a[nct][nct];
+  }
+  if (nrt + 1 < n) {
+    e[nrt] = a[nrt][n - 1];
+  }
+  e[n - 1] = 0.0;
+  for (int j = nct; j < n; ++j) {
+    for (int i = 0; i < m; ++i) {
+      u[i][j] = 0.0;
+    }
+    u[j][j] = 1.0;
+  }
+  for (int k = nct - 1; k >= 0; --k) {
+    if (s[k]) {
+      ApplyReflector(u, k, m, k, k + 1, n);
+      for (int i = k; i < m; ++i) {
+        u[i][k] = -u[i][k];
+      }
+      u[k][k] += 1.0;
+      for (int i = 0; i < k; ++i) {
+        u[i][k] = 0.0;
+      }
+    } else {
+      for (int i = 0; i < m; ++i) {
+        u[i][k] = 0.0;
+      }
+      u[k][k] = 1.0;
+    }
+  }
+  for (int k = n - 1; k >= 0; --k) {
+    if (k < nrt && e[k]) {
+      ApplyReflector(v, k + 1, n, k, k + 1, n);
+    }
+    for (int i = 0; i < n; ++i) {
+      v[i][k] = 0.0;
+    }
+    v[k][k] = 1.0;
+  }
+  Diagonalize(e, m, n);
+}
+
+// Implicit-shift QR iterations on the bidiagonal matrix with diagonal
+// values_ and superdiagonal e, followed by sign fixing and sorting. The QR
+// sweeps are capped at kMaxSweeps per column.
+void S21SVD::Diagonalize(std::vector<double>& e, const int rows,
+                         const int cols) {
+  const int kMaxSweeps = 75;
+  std::vector<double>& s = values_;
+  const std::vector<double*> u = RowPointers(u_);
+  const std::vector<double*> v = RowPointers(v_);
+  const double eps = ldexp(1.0, -52);
+  const double tiny = ldexp(1.0, -966);
+  const int last_index = cols - 1;
+  int p = cols;
+  int sweeps = 0;
+  while (p > 0) {
+    int k = p - 2;
+    for (; k >= 0; --k) {
+      if (fabs(e[k]) <= tiny + eps * (fabs(s[k]) + fabs(s[k + 1]))) {
+        e[k] = 0.0;
+        break;
+      }
+    }
+    int kase = 4;
+    if (k != p - 2) {
+      int ks = p - 1;
+      for (; ks > k; --ks) {
+        const double t = (ks != p ? fabs(e[ks]) : 0.0) +
+                         (ks != k + 1 ? fabs(e[ks - 1]) : 0.0);
+        if (fabs(s[ks]) <= tiny + eps * t) {
+          s[ks] = 0.0;
+          break;
+        }
+      }
+      if (ks == k) {
+        kase = 3;
+      } else if (ks == p - 1) {
+        kase = 1;
+      } else {
+        kase = 2;
+        k = ks;
+      }
+    }
+    ++k;
+    if (kase == 1) {
+      double f = e[p - 2];
+      e[p - 2] = 0.0;
+      for (int j = p - 2; j >= k; --j) {
+        const double t = hypot(s[j], f);
+        const double cs = s[j] / t;
+        const double sn = f / t;
+        s[j] = t;
+        if (j != k) {
+          f = -sn * e[j - 1];
+          e[j - 1] = cs * e[j - 1];
+        }
+        RotateColumns(v, j, p - 1, cs, sn);
+      }
+    } else if (kase == 2) {
+      double f = e[k - 1];
+      e[k - 1] = 0.0;
+      for (int j = k; j < p; ++j) {
+        const double t = hypot(s[j], f);
+        const double cs = s[j] / t;
+        const double sn = f / t;
+        s[j] = t;
+        f = -sn * e[j];
+        e[j] = cs * e[j];
+        RotateColumns(u, j, k - 1, cs, sn);
+      }
+    } else if (kase == 3) {
+      if (++sweeps > kMaxSweeps * cols) {
+        throw std::runtime_error("SVD: did not converge");
+      }
+      const double scale =
+          std::max({fabs(s[p - 1]), fabs(s[p - 2]), fabs(e[p - 2]),
+                    fabs(s[k]), fabs(e[k])});
+      if (!scale) {
+        e[p - 2] = 0.0;
+        continue;
+      }
+      const double sp = s[p - 1] / scale;
+      const double spm1 = s[p - 2] / scale;
+      const double epm1 = e[p - 2] / scale;
+      const double sk = s[k] / scale;
+      const double ek = e[k] / scale;
+      const double b = ((spm1 + sp) * (spm1 - sp) + epm1 * epm1) / 2.0;
+      const double c = (sp * epm1) * (sp * epm1);
+      double shift = 0.0;
+      if (b != 0.0 || c != 0.0) {
+        shift = sqrt(b * b + c);
+        if (b < 0.0) {
+          shift = -shift;
+        }
+        shift = c / (b + shift);
+      }
+      double f = (sk + sp) * (sk - sp) + shift;
+      double g = sk * ek;
+      for (int j = k; j < p - 1; ++j) {
+        double t = hypot(f, g);
+        double cs = f / t;
+        double sn = g / t;
+        if (j != k) {
+          e[j - 1] = t;
+        }
+        f = cs * s[j] + sn * e[j];
+        e[j] = cs * e[j] - sn * s[j];
+        g = sn * s[j + 1];
+        s[j + 1] = cs * s[j + 1];
+        RotateColumns(v, j, j + 1, cs, sn);
+        t = hypot(f, g);
+        cs = f / t;
+        sn = g / t;
+        s[j] = t;
+        f = cs * e[j] + sn * s[j + 1];
+        s[j + 1] = -sn * e[j] + cs * s[j + 1];
+        g = sn * e[j + 1];
+        e[j + 1] = cs * e[j + 1];
+        if (j < rows - 1) {
+          RotateColumns(u, j, j + 1, cs, sn);
+        }
+      }
+      e[p - 2] = f;
+    } else {
+      if (s[k] <= 0.0) {
+        s[k] = s[k] < 0.0 ? -s[k] : 0.0;
+        for (double* row : v) {
+          row[k] = -row[k];
+        }
+      }
+      while (k < last_index && s[k] < s[k + 1]) {
+        std::swap(s[k], s[k + 1]);
+        SwapColumns(v, k, k + 1);
+        if (k < rows - 1) {
+          SwapColumns(u, k, k + 1);
+        }
+        ++k;
+      }
+      --p;
+    }
+  }
+}
+
+void S21SVD::Truncate(const int rank) {
+  values_.resize(rank);
+  u_.set_cols(rank);
+  v_.set_cols(rank);
+}
+
+}  // namespace s21
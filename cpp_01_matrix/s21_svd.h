@@ -0,0 +1,46 @@
+#ifndef CPP1_S21_MATRIXPLUS_4_S21_SVD_H_
+#define CPP1_S21_MATRIXPLUS_4_S21_SVD_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+namespace s21 {
+
+// Thin singular value decomposition A = U * diag(s) * V^T with singular values
+// in descending order. The full decomposition reduces A to bidiagonal form by
+// Householder reflections and diagonalizes it with implicit-shift QR
+// (Golub-Kahan-Reinsch). Randomized() computes only the leading triplets from
+// a Gaussian sketch refined by power iterations. Matrices with NaN or infinite
+// elements are rejected.
+class S21SVD {
+ public:
+  explicit S21SVD(const S21Matrix &matrix);
+  static S21SVD Randomized(
+      const S21Matrix &matrix, const int rank,
+      const int oversampling = kDefaultOversampling,
+      const int power_iterations = kDefaultPowerIterations,
+      const unsigned long seed = kDefaultSeed);
+
+  const S21Matrix &get_u() const noexcept;
+  const std::vector<double> &get_singular_values() const noexcept;
+  const S21Matrix &get_v() const noexcept;
+  S21Matrix Reconstruct() const;
+
+  static constexpr int kDefaultOversampling = 10;
+  static constexpr int kDefaultPowerIterations = 2;
+  static constexpr unsigned long kDefaultSeed = 5489;
+
+ private:
+  S21SVD() = default;
+  void Decompose(S21Matrix &matrix);
+  void Diagonalize(std::vector<double> &e, const int rows, const int cols);
+  void Truncate(const int rank);
+  S21Matrix u_;
+  std::vector<double> values_;
+  S21Matrix v_;
+};
+
+}  // namespace s21
+
+#endif  // CPP1_S21_MATRIXPLUS_4_S21_SVD_H_
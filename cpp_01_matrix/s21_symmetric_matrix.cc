@@ -0,0 +1,218 @@
+#include "s21_symmetric_matrix.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "s21_matrix_stats.h"
+#include "s21_parallel.h"
+
+namespace s21 {
+
+namespace {
+
+double Dot(const double* lhs, const double* rhs, const int size) noexcept {
+  double result = 0.0;
+  for (int i = 0; i < size; ++i) {
+    result += lhs[i] * rhs[i];
+  }
+  return result;
+}
+
+}  // namespace
+
+S21SymmetricMatrix::S21SymmetricMatrix(const int size) : size_(size) {
+  if (size < 0) {
+    throw std::invalid_argument("Constructor: negative size");
+  }
+  data_.assign(static_cast<size_t>(size) * (size + 1) / 2, 0.0);
+}
+
+S21SymmetricMatrix::S21SymmetricMatrix(const S21Matrix& matrix)
+    : S21SymmetricMatrix(matrix.get_rows()) {
+  if (matrix.get_rows() != matrix.get_cols()) {
+    throw std::invalid_argument("Constructor: matrix isn't square");
+  }
+  for (int i = 0; i < size_; ++i) {
+    std::copy(matrix[i], matrix[i] + i + 1, Row(i));
+  }
+}
+
+int S21SymmetricMatrix::get_size() const noexcept { return size_; }
+
+double& S21SymmetricMatrix::operator()(const int row, const int col) {
+  return data_[FindIndex(row, col)];
+}
+
+double S21SymmetricMatrix::operator()(const int row, const int col) const {
+  return data_[FindIndex(row, col)];
+}
+
+double* S21SymmetricMatrix::data() noexcept { return data_.data(); }
+
+const double* S21SymmetricMatrix::data() const noexcept {
+  return data_.data();
+}
+
+// Lower triangle of matrix^T * matrix, or of matrix * matrix^T when outer is
+// set, computed straight from the row-major operand.
+S21SymmetricMatrix S21SymmetricMatrix::Gram(const S21Matrix& matrix,
+                                            const bool outer) {
+  const int rows = matrix.get_rows();
+  const int cols = matrix.get_cols();
+  S21SymmetricMatrix result(outer ? rows : cols);
+  const int size = result.size_;
+  const int inner = outer ? cols : rows;
+  S21_STATS_OPERATION(stats::kGram,
+                      static_cast<double>(size) * (size + 1) * inner);
+  const double* source = matrix.data();
+  const long work = static_cast<long>(size) * inner;
+  if (outer) {
+    ForBalancedRows(size, work, [&](const int i) {
+      double* target = result.Row(i);
+      const double* row = source + static_cast<size_t>(i) * cols;
+      for (int j = 0; j <= i; ++j) {
+        target[j] = Dot(row, source + static_cast<size_t>(j) * cols, cols);
+      }
+    });
+  } else {
+    ForBalancedRows(size, work, [&](const int i) {
+      double* target = result.Row(i);
+      for (int k = 0; k < rows; ++k) {
+        const double* row = source + static_cast<size_t>(k) * cols;
+        const double value = row[i];
+        for (int j = 0; j <= i; ++j) {
+          target[j] += value * row[j];
+        }
+      }
+    });
+  }
+  return result;
+}
+
+S21Matrix S21SymmetricMatrix::ToMatrix() const {
+  S21Matrix result(size_);
+  for (int i = 0; i < size_; ++i) {
+    const double* row = Row(i);
+    for (int j = 0; j <= i; ++j) {
+      result[i][j] = row[j];
+      result[j][i] = row[j];
+    }
+  }
+  return result;
+}
+
+S21Matrix S21SymmetricMatrix::operator*(const S21Matrix& rhs) const {
+  if (rhs.get_rows() != size_) {
+    throw std::logic_error("Symmetric: M1(cols) != M2(rows)");
+  }
+  const int cols = rhs.get_cols();
+  S21_STATS_OPERATION(stats::kSymmetricMul,
+                      2.0 * static_cast<double>(size_) * size_ * cols);
+  S21Matrix result(size_, cols);
+  const double* in = rhs.data();
+  double* out = result.data();
+  const long work = static_cast<long>(size_) * cols;
+  const int grain = static_cast<int>(std::max(1L, (1L << 16) / (work + 1)));
+  parallel::For(0, size_, grain, [&](const int first, const int last) {
+    for (int i = first; i < last; ++i) {
+      const double* row = Row(i);
+      double* target = out + static_cast<size_t>(i) * cols;
+      for (int k = 0; k < size_; ++k) {
+        const double value = k <= i ? row[k] : Row(k)[i];
+        const double* source = in + static_cast<size_t>(k) * cols;
+        for (int j = 0; j < cols; ++j) {
+          target[j] += value * source[j];
+        }
+      }
+    }
+  });
+  return result;
+}
+
+// Left-looking blocked Cholesky factorization A = L * L^T. Within a block of
+// rows the part left of the block only depends on finished rows, so those
+// rows are computed in parallel; the diagonal block is done sequentially.
+S21TriangularMatrix S21SymmetricMatrix::Cholesky() const {
+  if (!size_) {
+    throw std::logic_error("Cholesky: operation with NULL matrix");
+  }
+  S21_STATS_OPERATION(stats::kCholesky,
+                      static_cast<double>(size_) * size_ * size_ / 3.0);
+  S21TriangularMatrix result(size_);
+  double* factors = result.data();
+  std::copy(data_.begin(), data_.end(), factors);
+  auto row = [factors](const int i) {
+    return factors + static_cast<size_t>(i) * (i + 1) / 2;
+  };
+  for (int first = 0; first < size_; first += kBlock) {
+    const int last = std::min(size_, first + kBlock);
+    const long work = static_cast<long>(first) * first / 2;
+    const int grain = static_cast<int>(std::max(1L, (1L << 16) / (work + 1)));
+    parallel::For(first, last, grain, [&](const int begin, const int end) {
+      for (int i = begin; i < end; ++i) {
+        double* target = row(i);
+        for (int j = 0; j < first; ++j) {
+          const double* other = row(j);
+          target[j] = (target[j] - Dot(target, other, j)) / other[j];
+        }
+      }
+    });
+    for (int i = first; i < last; ++i) {
+      double* target = row(i);
+      for (int j = first; j < i; ++j) {
+        const double* other = row(j);
+        target[j] = (target[j] - Dot(target, other, j)) / other[j];
+      }
+      const double diagonal = target[i] - Dot(target, target, i);
+      if (!(diagonal > 0.0)) {
+        throw std::logic_error("Cholesky: matrix isn't positive definite");
+      }
+      target[i] = sqrt(diagonal);
+    }
+  }
+  return result;
+}
+
+S21Matrix S21SymmetricMatrix::Solve(const S21Matrix& rhs) const {
+  if (rhs.get_rows() != size_) {
+    throw std::logic_error("Symmetric: rhs(rows) != matrix(rows)");
+  }
+  const S21TriangularMatrix factor = Cholesky();
+  return factor.Transpose().Solve(factor.Solve(rhs));
+}
+
+double* S21SymmetricMatrix::Row(const int row) noexcept {
+  return data_.data() + static_cast<size_t>(row) * (row + 1) / 2;
+}
+
+const double* S21SymmetricMatrix::Row(const int row) const noexcept {
+  return data_.data() + static_cast<size_t>(row) * (row + 1) / 2;
+}
+
+size_t S21SymmetricMatrix::FindIndex(const int row, const int col) const {
+  if (row < 1 || col < 1 || row > size_ || col > size_) {
+    throw std::logic_error("(): element doesn't exist");
+  }
+  const size_t i = std::max(row, col) - 1;
+  return i * (i + 1) / 2 + std::min(row, col) - 1;
+}
+
+// Calls function(row) for every row of a lower triangle, pairing row i with
+// row size - 1 - i so that every thread gets the same amount of work.
+template <typename Function>
+void S21SymmetricMatrix::ForBalancedRows(const int size, const long work,
+                                         Function&& function) {
+  const int grain = static_cast<int>(std::max(1L, (1L << 16) / (work + 1)));
+  parallel::For(0, (size + 1) / 2, grain, [&](const int first, const int last) {
+    for (int i = first; i < last; ++i) {
+      function(i);
+      if (size - 1 - i != i) {
+        function(size - 1 - i);
+      }
+    }
+  });
+}
+
+}  // namespace s21
@@ -0,0 +1,47 @@
+#ifndef CPP1_S21_MATRIXPLUS_4_S21_SYMMETRIC_MATRIX_H_
+#define CPP1_S21_MATRIXPLUS_4_S21_SYMMETRIC_MATRIX_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+#include "s21_triangular_matrix.h"
+
+namespace s21 {
+
+// Symmetric matrix that stores only its lower triangle, packed row by row in
+// the same layout as a lower S21TriangularMatrix. Indices are 1-based and
+// (row, col) and (col, row) refer to the same element.
+class S21SymmetricMatrix {
+ public:
+  explicit S21SymmetricMatrix(const int size = 0);
+  explicit S21SymmetricMatrix(const S21Matrix &matrix);
+
+  int get_size() const noexcept;
+  double &operator()(const int row, const int col);
+  double operator()(const int row, const int col) const;
+  double *data() noexcept;
+  const double *data() const noexcept;
+
+  static S21SymmetricMatrix Gram(const S21Matrix &matrix,
+                                 const bool outer = false);
+  S21Matrix ToMatrix() const;
+  S21Matrix operator*(const S21Matrix &rhs) const;
+  S21TriangularMatrix Cholesky() const;
+  S21Matrix Solve(const S21Matrix &rhs) const;
+
+  static constexpr int kBlock = 64;
+
+ private:
+  double *Row(const int row) noexcept;
+  const double *Row(const int row) const noexcept;
+  size_t FindIndex(const int row, const int col) const;
+  template <typename Function>
+  static void ForBalancedRows(const int size, const long work,
+                              Function &&function);
+  std::vector<double> data_;
+  int size_{0};
+};
+
+}  // namespace s21
+
+#endif  // CPP1_S21_MATRIXPLUS_4_S21_SYMMETRIC_MATRIX_H_
@@ -0,0 +1,230 @@
+#include "s21_triangular_matrix.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "s21_matrix_stats.h"
+#include "s21_parallel.h"
+
+namespace s21 {
+
+S21TriangularMatrix::S21TriangularMatrix(const int size,
+                                         const Triangle triangle,
+                                         const bool unit_diagonal)
+    : size_(size), triangle_(triangle), unit_diagonal_(unit_diagonal) {
+  if (size < 0) {
+    throw std::invalid_argument("Constructor: negative size");
+  }
+  data_.assign(static_cast<size_t>(size) * (size + 1) / 2, 0.0);
+}
+
+S21TriangularMatrix::S21TriangularMatrix(const S21Matrix& matrix,
+                                         const Triangle triangle,
+                                         const bool unit_diagonal)
+    : S21TriangularMatrix(matrix.get_rows(), triangle, unit_diagonal) {
+  if (matrix.get_rows() != matrix.get_cols()) {
+    throw std::invalid_argument("Constructor: matrix isn't square");
+  }
+  for (int i = 0; i < size_; ++i) {
+    const int first = triangle_ == kLower ? 0 : i;
+    const int last = triangle_ == kLower ? i + 1 : size_;
+    std::copy(matrix[i] + first, matrix[i] + last, Row(i) + first);
+  }
+}
+
+int S21TriangularMatrix::get_size() const noexcept { return size_; }
+
+S21TriangularMatrix::Triangle S21TriangularMatrix::get_triangle()
+    const noexcept {
+  return triangle_;
+}
+
+bool S21TriangularMatrix::get_unit_diagonal() const noexcept {
+  return unit_diagonal_;
+}
+
+double& S21TriangularMatrix::operator()(const int row, const int col) {
+  CheckIndex(row, col);
+  if ((triangle_ == kLower ? col > row : col < row) ||
+      (unit_diagonal_ && row == col)) {
+    throw std::logic_error("(): element isn't stored");
+  }
+  return Row(row - 1)[col - 1];
+}
+
+double S21TriangularMatrix::operator()(const int row, const int col) const {
+  CheckIndex(row, col);
+  if (triangle_ == kLower ? col > row : col < row) {
+    return 0.0;
+  }
+  return unit_diagonal_ && row == col ? 1.0 : Row(row - 1)[col - 1];
+}
+
+double* S21TriangularMatrix::data() noexcept { return data_.data(); }
+
+const double* S21TriangularMatrix::data() const noexcept {
+  return data_.data();
+}
+
+S21Matrix S21TriangularMatrix::ToMatrix() const {
+  S21Matrix result(size_);
+  for (int i = 0; i < size_; ++i) {
+    const int first = triangle_ == kLower ? 0 : i;
+    const int last = triangle_ == kLower ? i + 1 : size_;
+    std::copy(Row(i) + first, Row(i) + last, result[i] + first);
+    if (unit_diagonal_) {
+      result[i][i] = 1.0;
+    }
+  }
+  return result;
+}
+
+S21TriangularMatrix S21TriangularMatrix::Transpose() const {
+  S21TriangularMatrix result(size_, triangle_ == kLower ? kUpper : kLower,
+                             unit_diagonal_);
+  for (int i = 0; i < size_; ++i) {
+    const int first = triangle_ == kLower ? 0 : i;
+    const int last = triangle_ == kLower ? i + 1 : size_;
+    for (int j = first; j < last; ++j) {
+      result.Row(j)[i] = Row(i)[j];
+    }
+  }
+  return result;
+}
+
+S21Matrix S21TriangularMatrix::Solve(const S21Matrix& rhs) const {
+  if (rhs.get_rows() != size_) {
+    throw std::logic_error("Triangular: rhs(rows) != matrix(rows)");
+  }
+  S21Matrix result{rhs};
+  Solve(result.data(), result.get_cols());
+  return result;
+}
+
+// Solves T * X = B in place, rhs holds B as a row-major size x cols block.
+void S21TriangularMatrix::Solve(double* rhs, const int cols) const {
+  if (!unit_diagonal_) {
+    for (int i = 0; i < size_; ++i) {
+      if (!Row(i)[i]) {
+        throw std::logic_error("Determinant is zero");
+      }
+    }
+  }
+  S21_STATS_OPERATION(stats::kTriangularSolve,
+                      static_cast<double>(size_) * size_ * cols);
+  const long work = static_cast<long>(kBlock) * cols;
+  const int grain = static_cast<int>(std::max(1L, (1L << 16) / (work + 1)));
+  auto update = [&](const int first, const int last, const int k_first,
+                    const int k_last) {
+    parallel::For(first, last, grain, [&](const int begin, const int end) {
+      Accumulate(begin, end, k_first, k_last, rhs, rhs, cols, 0, cols, -1.0);
+    });
+  };
+  if (triangle_ == kLower) {
+    for (int first = 0; first < size_; first += kBlock) {
+      const int last = std::min(size_, first + kBlock);
+      SolveDiagonal(first, last, rhs, cols);
+      update(last, size_, first, last);
+    }
+  } else {
+    for (int last = size_; last > 0; last -= kBlock) {
+      const int first = std::max(0, last - kBlock);
+      SolveDiagonal(first, last, rhs, cols);
+      update(0, first, first, last);
+    }
+  }
+}
+
+S21Matrix S21TriangularMatrix::operator*(const S21Matrix& rhs) const {
+  if (rhs.get_rows() != size_) {
+    throw std::logic_error("Triangular: M1(cols) != M2(rows)");
+  }
+  const int cols = rhs.get_cols();
+  S21_STATS_OPERATION(stats::kTriangularMul,
+                      static_cast<double>(size_) * size_ * cols);
+  S21Matrix result(size_, cols);
+  const double* in = rhs.data();
+  double* out = result.data();
+  const long work = static_cast<long>(size_) * cols / 2;
+  const int grain = static_cast<int>(std::max(1L, (1L << 16) / (work + 1)));
+  parallel::For(0, size_, grain, [&](const int first, const int last) {
+    for (int k = 0; k < size_; k += kBlock) {
+      Accumulate(first, last, k, std::min(size_, k + kBlock), in, out, cols, 0,
+                 cols, 1.0);
+    }
+  });
+  return result;
+}
+
+size_t S21TriangularMatrix::RowOffset(const int row) const noexcept {
+  const size_t i = row;
+  return triangle_ == kLower ? i * (i + 1) / 2 : i * size_ - i * (i + 1) / 2;
+}
+
+double* S21TriangularMatrix::Row(const int row) noexcept {
+  return data_.data() + RowOffset(row);
+}
+
+const double* S21TriangularMatrix::Row(const int row) const noexcept {
+  return data_.data() + RowOffset(row);
+}
+
+void S21TriangularMatrix::CheckIndex(const int row, const int col) const {
+  if (row < 1 || col < 1 || row > size_ || col > size_) {
+    throw std::logic_error("(): element doesn't exist");
+  }
+}
+
+// out[i] += sign * T[i][k] * in[k] for rows i in [first, last), k in
+// [k_first, k_last) clipped to the stored triangle, and columns
+// [col_first, col_last) of the row-major blocks in and out.
+void S21TriangularMatrix::Accumulate(const int first, const int last,
+                                     const int k_first, const int k_last,
+                                     const double* in, double* out,
+                                     const int stride, const int col_first,
+                                     const int col_last,
+                                     const double sign) const noexcept {
+  for (int i = first; i < last; ++i) {
+    const double* row = Row(i);
+    double* target = out + static_cast<size_t>(i) * stride;
+    const int k_begin = triangle_ == kLower ? k_first : std::max(k_first, i);
+    const int k_end = triangle_ == kLower ? std::min(k_last, i + 1) : k_last;
+    for (int k = k_begin; k < k_end; ++k) {
+      const double value = sign * (unit_diagonal_ && k == i ? 1.0 : row[k]);
+      const double* source = in + static_cast<size_t>(k) * stride;
+      for (int j = col_first; j < col_last; ++j) {
+        target[j] += value * source[j];
+      }
+    }
+  }
+}
+
+// Substitution inside the diagonal block [first, last), the columns of the
+// right-hand side are independent and are split between threads.
+void S21TriangularMatrix::SolveDiagonal(const int first, const int last,
+                                        double* rhs,
+                                        const int cols) const {
+  const int size = last - first;
+  const int grain = std::max(1, (1 << 16) / (size * size + 1));
+  parallel::For(0, cols, grain, [&](const int col_first, const int col_last) {
+    for (int step = 0; step < size; ++step) {
+      const int i = triangle_ == kLower ? first + step : last - 1 - step;
+      if (triangle_ == kLower) {
+        Accumulate(i, i + 1, first, i, rhs, rhs, cols, col_first, col_last,
+                   -1.0);
+      } else {
+        Accumulate(i, i + 1, i + 1, last, rhs, rhs, cols, col_first, col_last,
+                   -1.0);
+      }
+      if (!unit_diagonal_) {
+        double* target = rhs + static_cast<size_t>(i) * cols;
+        const double scale = 1.0 / Row(i)[i];
+        for (int j = col_first; j < col_last; ++j) {
+          target[j] *= scale;
+        }
+      }
+    }
+  });
+}
+
+}  // namespace s21
@@ -0,0 +1,60 @@
+#ifndef CPP1_S21_MATRIXPLUS_4_S21_TRIANGULAR_MATRIX_H_
+#define CPP1_S21_MATRIXPLUS_4_S21_TRIANGULAR_MATRIX_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+namespace s21 {
+
+// Square lower or upper triangular matrix in packed row-major storage, only
+// the n * (n + 1) / 2 elements of the triangle are kept. Solves and products
+// are blocked: diagonal blocks are handled by substitution, off-diagonal
+// blocks by a multithreaded GEMM update. Indices are 1-based like in
+// S21Matrix; the non-const operator() only reaches stored elements.
+class S21TriangularMatrix {
+ public:
+  enum Triangle { kLower, kUpper };
+
+  explicit S21TriangularMatrix(const int size = 0,
+                               const Triangle triangle = kLower,
+                               const bool unit_diagonal = false);
+  S21TriangularMatrix(const S21Matrix &matrix, const Triangle triangle = kLower,
+                      const bool unit_diagonal = false);
+
+  int get_size() const noexcept;
+  Triangle get_triangle() const noexcept;
+  bool get_unit_diagonal() const noexcept;
+  double &operator()(const int row, const int col);
+  double operator()(const int row, const int col) const;
+  double *data() noexcept;
+  const double *data() const noexcept;
+
+  S21Matrix ToMatrix() const;
+  S21TriangularMatrix Transpose() const;
+  S21Matrix Solve(const S21Matrix &rhs) const;
+  void Solve(double *rhs, const int cols = 1) const;
+  S21Matrix operator*(const S21Matrix &rhs) const;
+
+  static constexpr int kBlock = 64;
+
+ private:
+  size_t RowOffset(const int row) const noexcept;
+  double *Row(const int row) noexcept;
+  const double *Row(const int row) const noexcept;
+  void CheckIndex(const int row, const int col) const;
+  void Accumulate(const int first, const int last, const int k_first,
+                  const int k_last, const double *in, double *out,
+                  const int stride, const int col_first, const int col_last,
+                  const double sign) const noexcept;
+  void SolveDiagonal(const int first, const int last, double *rhs,
+                     const int cols) const;
+  std::vector<double> data_;
+  int size_{0};
+  Triangle triangle_{kLower};
+  bool unit_diagonal_{false};
+};
+
+}  // namespace s21
+
+#endif  // CPP1_S21_MATRIXPLUS_4_S21_TRIANGULAR_MATRIX_H_
@@ -1,9 +1,298 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
 #include "../s21_matrix_oop.h"
+#include "../s21_matrix_stats.h"
+#include "../s21_numa.h"
+#include "../s21_parallel.h"
 
 namespace s21 {
 
+TEST(S21MatrixTest, InlineStorage) {
+  auto is_inline = [](const S21Matrix &matrix) {
+    const char *data = reinterpret_cast<const char *>(matrix.data());
+    const char *object = reinterpret_cast<const char *>(&matrix);
+    return data >= object && data < object + sizeof(matrix);
+  };
+  S21Matrix small(4, 4);
+  std::iota(small.begin(), small.end(), 1.0);
+  EXPECT_TRUE(is_inline(small));
+  EXPECT_FALSE(is_inline(S21Matrix(3, 6)));
+  S21Matrix copy = small;
+  EXPECT_TRUE(is_inline(copy));
+  EXPECT_TRUE(copy == small);
+  S21Matrix moved = std::move(copy);
+  EXPECT_TRUE(is_inline(moved));
+  EXPECT_TRUE(moved == small);
+  EXPECT_EQ(copy.get_rows(), 0);
+  EXPECT_EQ(copy.data(), nullptr);
+  EXPECT_EQ(copy.get_capacity(), 0u);
+  moved.set_size(5, 5);
+  EXPECT_FALSE(is_inline(moved));
+  EXPECT_DOUBLE_EQ(moved(4, 4), 16);
+  EXPECT_DOUBLE_EQ(moved(5, 5), 0);
+  moved.set_size(2, 3);
+  EXPECT_FALSE(is_inline(moved));
+  EXPECT_DOUBLE_EQ(moved(2, 3), 7);
+  S21Matrix large(6, 6);
+  large.Fill();
+  large = small;
+  EXPECT_TRUE(is_inline(large));
+  EXPECT_TRUE(large == small);
+  small.set_copy_on_write(true);
+  S21Matrix shared = small;
+  EXPECT_FALSE(small.IsShared());
+  shared(1, 1) = -1;
+  EXPECT_DOUBLE_EQ(small(1, 1), 1);
+  S21Matrix square(2, 2);
+  square(1, 1) = 1;
+  square(1, 2) = 1;
+  square(2, 2) = 1;
+  EXPECT_DOUBLE_EQ(square.Power(5)(1, 2), 5);
+}
+
+TEST(S21MatrixTest, SetSizeInPlace) {
+  S21Matrix matrix(5, 5);
+  std::iota(matrix.begin(), matrix.end(), 1.0);
+  const double *data = matrix.data();
+  EXPECT_EQ(matrix.get_capacity(), 25u);
+  matrix.set_size(3, 4);
+  EXPECT_EQ(matrix.data(), data);
+  EXPECT_DOUBLE_EQ(matrix(2, 1), 6);
+  EXPECT_DOUBLE_EQ(matrix(3, 4), 14);
+  matrix.set_size(4, 6);
+  EXPECT_EQ(matrix.data(), data);
+  EXPECT_DOUBLE_EQ(matrix(1, 4), 4);
+  EXPECT_DOUBLE_EQ(matrix(3, 3), 13);
+  EXPECT_DOUBLE_EQ(matrix(3, 5), 0);
+  EXPECT_DOUBLE_EQ(matrix(4, 1), 0);
+  matrix.set_size(5, 6);
+  EXPECT_NE(matrix.data(), data);
+  EXPECT_EQ(matrix.get_capacity(), 50u);
+  EXPECT_DOUBLE_EQ(matrix(3, 4), 14);
+  EXPECT_DOUBLE_EQ(matrix(5, 6), 0);
+}
+
+TEST(S21MatrixTest, AppendRows) {
+  S21Matrix matrix(1, 3);
+  int reallocations = 0;
+  for (int i = 1; i < 1000; ++i) {
+    const double *data = matrix.data();
+    matrix.set_rows(i + 1);
+    reallocations += matrix.data() != data;
+    matrix(i + 1, 2) = i;
+  }
+  EXPECT_LE(reallocations, 11);
+  EXPECT_GE(matrix.get_capacity(), 3000u);
+  for (int i = 1; i < 1000; ++i) {
+    EXPECT_DOUBLE_EQ(matrix(i + 1, 1), 0);
+    EXPECT_DOUBLE_EQ(matrix(i + 1, 2), i);
+  }
+  S21Matrix reserved(1, 3);
+  reserved.Reserve(100, 3);
+  EXPECT_EQ(reserved.get_capacity(), 300u);
+  const double *data = reserved.data();
+  reserved.set_rows(100);
+  EXPECT_EQ(reserved.data(), data);
+  EXPECT_ANY_THROW(reserved.Reserve(-1, 3));
+}
+
+TEST(S21MatrixTest, SetSizeShared) {
+  S21Matrix matrix(5, 5);
+  std::iota(matrix.begin(), matrix.end(), 1.0);
+  matrix.set_copy_on_write(true);
+  S21Matrix copy = matrix;
+  EXPECT_TRUE(matrix.IsShared());
+  matrix.set_size(2, 2);
+  EXPECT_FALSE(copy.IsShared());
+  EXPECT_EQ(copy.get_rows(), 5);
+  EXPECT_DOUBLE_EQ(copy(5, 5), 25);
+  S21Matrix shrunk(5, 5);
+  std::iota(shrunk.begin(), shrunk.end(), 1.0);
+  shrunk.set_copy_on_write(true);
+  shrunk.set_size(2, 2);
+  S21Matrix shared = shrunk;
+  EXPECT_TRUE(shrunk.IsShared());
+  shared(2, 2) = -1;
+  EXPECT_DOUBLE_EQ(shrunk(2, 2), 7);
+  EXPECT_FALSE(shrunk.IsShared());
+}
+
+TEST(S21MatrixTest, Kronecker) {
+  S21Matrix lhs(2, 3);
+  S21Matrix rhs(3, 5);
+  std::iota(lhs.begin(), lhs.end(), 1.0);
+  std::iota(rhs.begin(), rhs.end(), -7.0);
+  const S21Matrix result = lhs.Kronecker(rhs);
+  EXPECT_EQ(result.get_rows(), 6);
+  EXPECT_EQ(result.get_cols(), 15);
+  for (int i = 1; i <= 6; ++i) {
+    for (int j = 1; j <= 15; ++j) {
+      EXPECT_DOUBLE_EQ(result(i, j), lhs((i - 1) / 3 + 1, (j - 1) / 5 + 1) *
+                                         rhs((i - 1) % 3 + 1, (j - 1) % 5 + 1));
+    }
+  }
+  EXPECT_EQ(lhs.Kronecker(S21Matrix()).get_rows(), 0);
+}
+
+TEST(S21MatrixTest, Hadamard) {
+  S21Matrix lhs(7, 9);
+  S21Matrix rhs(7, 9);
+  std::iota(lhs.begin(), lhs.end(), 1.0);
+  std::iota(rhs.begin(), rhs.end(), 2.0);
+  S21Matrix product = lhs;
+  product.HadamardMul(rhs);
+  S21Matrix quotient = product;
+  quotient.HadamardDiv(rhs);
+  for (int i = 0; i < 63; ++i) {
+    EXPECT_DOUBLE_EQ(product.data()[i], (i + 1.0) * (i + 2.0));
+    EXPECT_DOUBLE_EQ(quotient.data()[i], i + 1.0);
+  }
+  lhs.set_copy_on_write(true);
+  S21Matrix shared = lhs;
+  shared.HadamardMul(lhs);
+  EXPECT_DOUBLE_EQ(shared(7, 9), 63 * 63);
+  EXPECT_DOUBLE_EQ(lhs(7, 9), 63);
+  lhs.HadamardDiv(lhs);
+  EXPECT_DOUBLE_EQ(lhs.Sum(), 63);
+  EXPECT_ANY_THROW(lhs.HadamardMul(S21Matrix(9, 7)));
+  EXPECT_ANY_THROW(lhs.HadamardDiv(S21Matrix(7, 8)));
+}
+
+TEST(S21MatrixTest, Apply) {
+  S21Matrix matrix(41, 37);
+  for (int i = 0; i < 41 * 37; ++i) {
+    matrix.data()[i] = (i - 700) / 20.0;
+  }
+  S21Matrix exp = matrix;
+  S21Matrix tanh = matrix;
+  S21Matrix relu = matrix;
+  exp.Apply(simd::ExpFunction());
+  tanh.Apply(simd::TanhFunction());
+  relu.Apply(simd::ReluFunction());
+  for (int i = 0; i < 41 * 37; ++i) {
+    const double x = matrix.data()[i];
+    EXPECT_NEAR(exp.data()[i], std::exp(x), 4e-16 * std::exp(x));
+    EXPECT_NEAR(tanh.data()[i], std::tanh(x), 4e-16 * std::fabs(std::tanh(x)));
+    EXPECT_EQ(relu.data()[i], std::max(x, 0.0));
+  }
+  S21Matrix edges(2, 4);
+  const double inputs[] = {0.0, -0.0, 1e-12, 800.0, -800.0, -740.0, 709.5, NAN};
+  std::copy(inputs, inputs + 8, edges.begin());
+  S21Matrix exp_edges = edges;
+  exp_edges.Apply(simd::ExpFunction());
+  edges.Apply(simd::TanhFunction());
+  for (int i = 0; i < 7; ++i) {
+    EXPECT_DOUBLE_EQ(exp_edges.data()[i], std::exp(inputs[i]));
+    EXPECT_DOUBLE_EQ(edges.data()[i], std::tanh(inputs[i]));
+  }
+  EXPECT_TRUE(std::signbit(edges.data()[1]));
+  EXPECT_TRUE(std::isnan(exp_edges.data()[7]));
+  S21Matrix scalar(3, 3);
+  std::fill(scalar.begin(), scalar.end(), 2.0);
+  scalar.Apply([](const double x) { return x * x + 1; });
+  EXPECT_DOUBLE_EQ(scalar.Sum(), 45);
+  scalar.Apply([](auto x) { return x * 0.5; });
+  EXPECT_DOUBLE_EQ(scalar.Sum(), 22.5);
+  S21Matrix large(300, 400);
+  std::iota(large.begin(), large.end(), -60000.0);
+  large.MulNumber(1e-4);
+  S21Matrix threaded = large;
+  parallel::SetThreadCount(3);
+  threaded.Apply(simd::TanhFunction());
+  const S21Matrix kronecker = threaded.Kronecker(scalar);
+  parallel::SetThreadCount(0);
+  large.Apply(simd::TanhFunction());
+  EXPECT_TRUE(threaded == large);
+  EXPECT_TRUE(kronecker == large.Kronecker(scalar));
+}
+
+TEST(S21MatrixTest, Placement) {
+  EXPECT_EQ(numa::GetPlacement(), numa::kLocal);
+  EXPECT_GE(numa::NodeCount(), 1);
+  parallel::SetThreadCount(3);
+  for (numa::Placement placement :
+       {numa::kLocal, numa::kFirstTouch, numa::kInterleave}) {
+    numa::SetPlacement(placement);
+    EXPECT_EQ(numa::GetPlacement(), placement);
+    S21Matrix matrix(1000, 300);
+    EXPECT_EQ(matrix.Min(), 0);
+    EXPECT_EQ(matrix.Max(), 0);
+    matrix(1000, 300) = 1;
+    matrix.set_rows(1001);
+    EXPECT_GE(matrix.get_capacity(), numa::kPlacedSize);
+    EXPECT_EQ(matrix.Sum(), 1);
+    S21Matrix copy = matrix;
+    matrix.set_size(0, 0);
+    EXPECT_EQ(copy(1000, 300), 1);
+    for (size_t size : {size_t{100003}, numa::kPlacedSize + 3}) {
+      double *values = numa::Allocate(size, 1000);
+      EXPECT_TRUE(std::all_of(values, values + size,
+                              [](const double value) { return value == 0; }));
+      values[size - 1] = 1;
+      numa::Deallocate(values, size);
+    }
+  }
+  numa::SetPlacement(numa::kLocal);
+  parallel::SetThreadCount(0);
+}
+
+TEST(S21MatrixTest, FillRandom) {
+  S21Matrix serial(301, 203);
+  serial.FillRandom(42);
+  parallel::SetThreadCount(3);
+  S21Matrix threaded(301, 203);
+  threaded.FillRandom(42);
+  S21Matrix column(301 * 203, 1);
+  column.FillRandom(42);
+  parallel::SetThreadCount(0);
+  EXPECT_TRUE(serial == threaded);
+  EXPECT_TRUE(std::equal(serial.begin(), serial.end(), column.begin()));
+  EXPECT_GE(serial.Min(), 0);
+  EXPECT_LT(serial.Max(), 1);
+  EXPECT_NEAR(serial.Sum() / (301 * 203), 0.5, 0.01);
+  S21Matrix other(301, 203);
+  other.FillRandom(43);
+  EXPECT_FALSE(serial == other);
+  S21Matrix normal(301, 203);
+  normal.FillRandom(7, S21Matrix::kNormal, 2.0, 3.0);
+  EXPECT_NEAR(normal.Sum() / (301 * 203), 2.0, 0.05);
+  S21Matrix shift(301, 203);
+  shift.FillConstant(2.0);
+  normal -= shift;
+  EXPECT_NEAR(normal.Dot(normal) / (301 * 203), 9.0, 0.2);
+  S21Matrix odd(3, 3);
+  odd.FillRandom(42, S21Matrix::kUniform, -1.0, 2.0);
+  for (int i = 0; i < 9; ++i) {
+    EXPECT_DOUBLE_EQ(odd.data()[i], 2 * serial.data()[i] - 1);
+  }
+}
+
+TEST(S21MatrixTest, FillPatterns) {
+  S21Matrix matrix(300, 200);
+  parallel::SetThreadCount(3);
+  matrix.FillConstant(2.5);
+  parallel::SetThreadCount(0);
+  EXPECT_DOUBLE_EQ(matrix.Min(), 2.5);
+  EXPECT_DOUBLE_EQ(matrix.Max(), 2.5);
+  matrix.FillIdentity();
+  EXPECT_DOUBLE_EQ(matrix.Sum(), 200);
+  EXPECT_DOUBLE_EQ(matrix(200, 200), 1);
+  matrix.FillDiagonal(-3.0);
+  EXPECT_DOUBLE_EQ(matrix(200, 200), -3);
+  EXPECT_DOUBLE_EQ(matrix.Sum(), -600);
+  S21Matrix square(3, 3);
+  const double diagonal[] = {1, 2, 3};
+  square.FillDiagonal(diagonal);
+  EXPECT_DOUBLE_EQ(square.Determinant(), 6);
+  EXPECT_DOUBLE_EQ(square.Sum(), 6);
+}
+
 void CompareMatrices(const S21Matrix &m1, const S21Matrix &m2);
 void CompareTransposed(const S21Matrix &m1, const S21Matrix &m2);
 
@@ -319,6 +608,167 @@ TEST(S21MatrixTest, Transpose3) {
   CompareTransposed(m1, m2);
 }
 
+TEST(S21MatrixTest, ApproxEqual) {
+  S21Matrix m1(3, 4);
+  S21Matrix m2(3, 4);
+  m1.Fill();
+  m2.Fill();
+  EXPECT_TRUE(m1.ApproxEqual(m2));
+  EXPECT_FALSE(m1.ApproxEqual(S21Matrix(4, 3)));
+  EXPECT_TRUE(S21Matrix().ApproxEqual(S21Matrix()));
+  m2(3, 4) += 1e-9;
+  EXPECT_FALSE(m1 == m2);
+  EXPECT_TRUE(m1.ApproxEqual(m2));
+  EXPECT_FALSE(m1.ApproxEqual(m2, 1e-10));
+  m2(3, 4) = 12 * (1 + 1e-6);
+  EXPECT_FALSE(m1.ApproxEqual(m2));
+  EXPECT_TRUE(m1.ApproxEqual(m2, 0, 2e-6));
+  EXPECT_FALSE(m1.ApproxEqual(m2, 0, 5e-7));
+  m2(1, 1) = NAN;
+  EXPECT_FALSE(m1.ApproxEqual(m2, 1e300));
+  m2(1, 1) = INFINITY;
+  m2(2, 2) = -INFINITY;
+  EXPECT_TRUE(m2.ApproxEqual(S21Matrix(m2)));
+  EXPECT_FALSE(m1.ApproxEqual(m2, 1e300));
+  S21Matrix infinite(40, 40);
+  infinite.Fill();
+  infinite[39][38] = INFINITY;
+  infinite[0][1] = -INFINITY;
+  S21Matrix negated = infinite;
+  negated[39][38] = -INFINITY;
+  EXPECT_TRUE(infinite.ApproxEqual(S21Matrix(infinite)));
+  EXPECT_FALSE(infinite.ApproxEqual(negated, 1e300));
+  S21Matrix m3 = S21Matrix(3, 3).Exp();
+  S21Matrix identity(3, 3);
+  identity(1, 1) = identity(2, 2) = identity(3, 3) = 1;
+  EXPECT_TRUE(m3.ApproxEqual(identity, 1e-15));
+}
+
+TEST(S21MatrixTest, ApproxEqualLarge) {
+  S21Matrix m1(1100, 1000);
+  m1.Fill();
+  S21Matrix m2 = m1;
+  m2.MulNumber(1 + 1e-12);
+  parallel::SetThreadCount(3);
+  EXPECT_TRUE(m1.ApproxEqual(m2, 0, 1e-11));
+  m2[1099][999] += 1;
+  EXPECT_FALSE(m1.ApproxEqual(m2, 0, 1e-11));
+  m2[1099][999] -= 1;
+  m2[0][0] = -1;
+  EXPECT_FALSE(m1.ApproxEqual(m2, 0, 1e-11));
+  parallel::SetThreadCount(0);
+  EXPECT_FALSE(m1.ApproxEqual(m2, 0, 1e-11));
+}
+
+TEST(S21MatrixTest, Reductions) {
+  S21Matrix m1(3, 4);
+  std::iota(m1.begin(), m1.end(), -5.0);
+  EXPECT_DOUBLE_EQ(m1.Sum(), 6);
+  EXPECT_DOUBLE_EQ(m1.Dot(m1), 146);
+  EXPECT_DOUBLE_EQ(m1.NormFrobenius(), sqrt(146));
+  EXPECT_DOUBLE_EQ(m1.Norm1(), 10);
+  EXPECT_DOUBLE_EQ(m1.NormInf(), 18);
+  EXPECT_ANY_THROW(m1.Trace());
+  EXPECT_ANY_THROW(m1.Dot(S21Matrix(4, 3)));
+  S21Matrix with_nan(1, 2);
+  with_nan(1, 2) = NAN;
+  EXPECT_TRUE(std::isnan(with_nan.NormFrobenius()));
+  EXPECT_TRUE(std::isnan(with_nan.Norm1()));
+  EXPECT_TRUE(std::isnan(with_nan.NormInf()));
+  with_nan(1, 1) = INFINITY;
+  EXPECT_TRUE(std::isnan(with_nan.NormFrobenius()));
+  EXPECT_TRUE(std::isnan(with_nan.Norm1()));
+  EXPECT_TRUE(std::isnan(with_nan.NormInf()));
+  S21Matrix rows = m1.RowSums();
+  EXPECT_EQ(rows.get_rows(), 3);
+  EXPECT_EQ(rows.get_cols(), 1);
+  EXPECT_DOUBLE_EQ(rows(1, 1), -14);
+  EXPECT_DOUBLE_EQ(rows(2, 1), 2);
+  EXPECT_DOUBLE_EQ(rows(3, 1), 18);
+  S21Matrix cols = m1.ColSums();
+  EXPECT_EQ(cols.get_rows(), 1);
+  EXPECT_EQ(cols.get_cols(), 4);
+  EXPECT_DOUBLE_EQ(cols(1, 1), -3);
+  EXPECT_DOUBLE_EQ(cols(1, 4), 6);
+  m1.set_size(3, 3);
+  EXPECT_DOUBLE_EQ(m1.Trace(), 0);
+  m1(2, 2) = 7;
+  EXPECT_DOUBLE_EQ(m1.Trace(), 7);
+  S21Matrix empty;
+  EXPECT_DOUBLE_EQ(empty.Sum(), 0);
+  EXPECT_DOUBLE_EQ(empty.NormFrobenius(), 0);
+  EXPECT_DOUBLE_EQ(empty.Norm1(), 0);
+  EXPECT_DOUBLE_EQ(empty.NormInf(), 0);
+  EXPECT_EQ(empty.RowSums().get_rows(), 0);
+  EXPECT_EQ(empty.ColSums().get_cols(), 0);
+  EXPECT_ANY_THROW(empty.Trace());
+  EXPECT_ANY_THROW(empty.Min());
+}
+
+TEST(S21MatrixTest, MinMax) {
+  S21Matrix m1(4, 5);
+  m1.Fill();
+  m1(3, 2) = -7;
+  m1(2, 5) = 100;
+  m1(4, 4) = 100;
+  int row = 0;
+  int col = 0;
+  EXPECT_DOUBLE_EQ(m1.Min(&row, &col), -7);
+  EXPECT_EQ(row, 3);
+  EXPECT_EQ(col, 2);
+  EXPECT_DOUBLE_EQ(m1.Max(&row, &col), 100);
+  EXPECT_EQ(row, 2);
+  EXPECT_EQ(col, 5);
+  EXPECT_DOUBLE_EQ(m1.Max(), 100);
+  S21Matrix m2(1, 1);
+  m2(1, 1) = 3;
+  EXPECT_DOUBLE_EQ(m2.Min(&row, &col), 3);
+  EXPECT_EQ(row, 1);
+  EXPECT_EQ(col, 1);
+  m1(1, 1) = NAN;
+  m1(2, 3) = NAN;
+  m1(4, 5) = NAN;
+  EXPECT_DOUBLE_EQ(m1.Min(&row, &col), -7);
+  EXPECT_EQ(row, 3);
+  EXPECT_EQ(col, 2);
+  EXPECT_DOUBLE_EQ(m1.Max(&row, &col), 100);
+  EXPECT_EQ(row, 2);
+  EXPECT_EQ(col, 5);
+  S21Matrix m3(3, 3);
+  m3.FillConstant(NAN);
+  EXPECT_TRUE(std::isnan(m3.Max(&row, &col)));
+  EXPECT_EQ(row, 1);
+  EXPECT_EQ(col, 1);
+  m3(3, 1) = -INFINITY;
+  EXPECT_EQ(m3.Max(&row, &col), -INFINITY);
+  EXPECT_EQ(row, 3);
+  EXPECT_EQ(col, 1);
+}
+
+TEST(S21MatrixTest, ReductionsAccuracy) {
+  S21Matrix m1(1000, 1000);
+  for (auto row : m1.Rows()) {
+    for (double &value : row) {
+      value = 0.1;
+    }
+  }
+  m1[0][0] = 1e8;
+  EXPECT_NEAR(m1.Sum(), 1e8 + 99999.9, 1e-6);
+  EXPECT_NEAR(m1.ColSums()(1, 1), 1e8 + 99.9, 1e-7);
+  parallel::SetThreadCount(3);
+  const double threaded = m1.Sum();
+  parallel::SetThreadCount(1);
+  EXPECT_EQ(threaded, m1.Sum());
+  parallel::SetThreadCount(0);
+  S21Matrix m2(2, 2);
+  m2(1, 1) = 3e200;
+  m2(2, 2) = 4e200;
+  EXPECT_DOUBLE_EQ(m2.NormFrobenius(), 5e200);
+  m2(1, 1) = 3e-200;
+  m2(2, 2) = 4e-200;
+  EXPECT_DOUBLE_EQ(m2.NormFrobenius(), 5e-200);
+}
+
 TEST(S21MatrixTest, Compliment0) {
   S21Matrix m1(3, 2);
   EXPECT_ANY_THROW(m1.CalcComplements());
@@ -360,6 +810,51 @@ TEST(S21MatrixTest, Determinant1) {
   EXPECT_DOUBLE_EQ(m1.Determinant(), -297);
 }
 
+TEST(S21MatrixTest, IntegerDeterminant) {
+  EXPECT_ANY_THROW(S21Matrix(2, 3).IntegerDeterminant());
+  EXPECT_ANY_THROW(S21Matrix().IntegerDeterminant());
+  S21Matrix m1(1, 1);
+  m1(1, 1) = -17;
+  EXPECT_EQ(m1.IntegerDeterminant(), -17);
+  m1.set_size(3, 3);
+  m1.Fill();
+  EXPECT_EQ(m1.IntegerDeterminant(), 0);
+  m1(1, 1) = 100;
+  EXPECT_EQ(m1.IntegerDeterminant(), -297);
+  m1(1, 1) = 0;
+  m1(2, 1) = 0;
+  EXPECT_EQ(m1.IntegerDeterminant(), -21);
+  m1(2, 2) = 0.5;
+  EXPECT_THROW(m1.IntegerDeterminant(), std::domain_error);
+  m1(2, 2) = 1e19;
+  EXPECT_THROW(m1.IntegerDeterminant(), std::domain_error);
+}
+
+TEST(S21MatrixTest, IntegerDeterminantLarge) {
+  const int size = 40;
+  S21Matrix lower(size, size);
+  S21Matrix upper(size, size);
+  for (int i = 0; i < size; ++i) {
+    for (int j = 0; j < size; ++j) {
+      lower[i][j] = i > j ? (i * 3 + j) % 5 - 2 : (i == j);
+      upper[i][j] = i < j ? (i + j * 7) % 3 - 1 : (i == j);
+    }
+  }
+  S21Matrix unimodular = lower * upper;
+  EXPECT_EQ(unimodular.IntegerDeterminant(), 1);
+  for (int j = 0; j < size; ++j) {
+    std::swap(unimodular[0][j], unimodular[size - 1][j]);
+  }
+  EXPECT_EQ(unimodular.IntegerDeterminant(), -1);
+  S21Matrix diagonal(size, size);
+  for (int i = 0; i < size; ++i) {
+    diagonal[i][i] = i % 2 ? 2 : -2;
+  }
+  EXPECT_EQ(diagonal.IntegerDeterminant(), 1LL << size);
+  diagonal[0][0] = 1 << 30;
+  EXPECT_THROW(diagonal.IntegerDeterminant(), std::overflow_error);
+}
+
 TEST(S21MatrixTest, Inverse0) {
   S21Matrix m1(3, 1);
   EXPECT_ANY_THROW(m1.InverseMatrix());
@@ -572,6 +1067,431 @@ TEST(Matix, Show) {
   EXPECT_NO_THROW(std::cout << m1);
 }
 
+TEST(S21MatrixTest, MulMatrixThreads) {
+  S21Matrix m1(150, 140);
+  S21Matrix m2(140, 600);
+  m1.Fill(-3000);
+  m2.Fill(-2);
+  S21Matrix expected(150, 600);
+  for (int i = 1; i <= 150; ++i) {
+    for (int j = 1; j <= 600; ++j) {
+      for (int k = 1; k <= 140; ++k) {
+        expected(i, j) += m1(i, k) * m2(k, j);
+      }
+    }
+  }
+  parallel::SetThreadCount(4);
+  S21Matrix m3 = m1 * m2;
+  parallel::SetThreadCount(0);
+  CompareMatrices(m3, expected);
+}
+
+TEST(S21MatrixTest, ParallelFor) {
+  parallel::SetThreadCount(4);
+  std::vector<int> counts(1000);
+  parallel::For(0, 10, 1, [&](const int first, const int last) {
+    for (int i = first; i < last; ++i) {
+      parallel::For(0, 100, 1, [&](const int begin, const int end) {
+        for (int j = begin; j < end; ++j) {
+          ++counts[i * 100 + j];
+        }
+      });
+    }
+  });
+  EXPECT_EQ(std::count(counts.begin(), counts.end(), 1), 1000);
+  EXPECT_THROW(parallel::For(0, 100, 1,
+                             [](const int first, const int) {
+                               if (first) {
+                                 throw std::logic_error("chunk");
+                               }
+                             }),
+               std::logic_error);
+  std::atomic<int> sum{0};
+  parallel::For(0, 100, 1, [&](const int first, const int last) {
+    sum += last - first;
+  });
+  parallel::SetThreadCount(0);
+  EXPECT_EQ(sum.load(), 100);
+}
+
+TEST(S21MatrixTest, MulVector) {
+  S21Matrix m1(3, 5);
+  m1.Fill();
+  S21Matrix x(5, 1);
+  std::iota(x.begin(), x.end(), -2.0);
+  S21Matrix y(3, 1);
+  m1.MulVector(x, y);
+  CompareMatrices(y, m1 * x);
+  y.Fill(1);
+  m1.MulVector(x, y, false, 2.0, -1.0);
+  S21Matrix expected = m1 * x;
+  expected.MulNumber(2);
+  for (int i = 1; i <= 3; ++i) {
+    expected(i, 1) -= i;
+  }
+  CompareMatrices(y, expected);
+  S21Matrix z(5, 1);
+  y.Fill(1);
+  m1.MulVector(y, z, true);
+  CompareMatrices(z, m1.Transpose() * y);
+  z.Fill(1);
+  m1.MulVector(y, z, true, -1.0, 3.0);
+  expected = m1.Transpose() * y;
+  expected.MulNumber(-1);
+  for (int i = 1; i <= 5; ++i) {
+    expected(i, 1) += 3 * i;
+  }
+  CompareMatrices(z, expected);
+  EXPECT_ANY_THROW(m1.MulVector(y, z));
+  EXPECT_ANY_THROW(m1.MulVector(x, z));
+  EXPECT_ANY_THROW(m1.MulVector(x, y, true));
+  S21Matrix square(3, 3);
+  square.Fill();
+  EXPECT_ANY_THROW(square.MulVector(y, y));
+  S21Matrix large(20, 20);
+  large.Fill();
+  S21Matrix column(20, 1);
+  column.Fill();
+  column.set_copy_on_write(true);
+  S21Matrix shared = column;
+  large.MulVector(column, shared);
+  CompareMatrices(shared, large * column);
+}
+
+TEST(S21MatrixTest, MulVectorThreads) {
+  S21Matrix m1(301, 257);
+  std::iota(m1.begin(), m1.end(), -1000.0);
+  S21Matrix x(257, 1);
+  S21Matrix xt(301, 1);
+  std::iota(x.begin(), x.end(), 1.0);
+  std::iota(xt.begin(), xt.end(), 1.0);
+  S21Matrix y(301, 1);
+  S21Matrix yt(257, 1);
+  parallel::SetThreadCount(4);
+  m1.MulVector(x, y);
+  m1.MulVector(xt, yt, true);
+  parallel::SetThreadCount(0);
+  EXPECT_TRUE(y.ApproxEqual(m1 * x, 0, 1e-12));
+  EXPECT_TRUE(yt.ApproxEqual(m1.Transpose() * xt, 0, 1e-12));
+}
+
+TEST(S21MatrixTest, Power) {
+  S21Matrix m1(2, 2);
+  m1(1, 1) = 1;
+  m1(1, 2) = 1;
+  m1(2, 1) = 1;
+  S21Matrix m2 = m1.Power(10);
+  EXPECT_DOUBLE_EQ(m2(1, 1), 89);
+  EXPECT_DOUBLE_EQ(m2(1, 2), 55);
+  EXPECT_DOUBLE_EQ(m2(2, 1), 55);
+  EXPECT_DOUBLE_EQ(m2(2, 2), 34);
+
+  S21Matrix m3(4, 4);
+  m3.Fill();
+  S21Matrix m4 = m3;
+  for (int i = 1; i < 5; ++i) {
+    CompareMatrices(m3.Power(i), m4);
+    m4 *= m3;
+  }
+  S21Matrix identity(4, 4);
+  for (int i = 1; i <= 4; ++i) {
+    identity(i, i) = 1;
+  }
+  CompareMatrices(m3.Power(0), identity);
+}
+
+TEST(S21MatrixTest, PowerNegative) {
+  S21Matrix m1(3, 3);
+  m1(1, 1) = 2;
+  m1(1, 2) = 5;
+  m1(1, 3) = 7;
+  m1(2, 1) = 6;
+  m1(2, 2) = 3;
+  m1(2, 3) = 4;
+  m1(3, 1) = 5;
+  m1(3, 2) = -2;
+  m1(3, 3) = -3;
+  S21Matrix m2 = m1.Power(-2) * m1.Power(2);
+  for (int i = 1; i <= 3; ++i) {
+    for (int j = 1; j <= 3; ++j) {
+      EXPECT_NEAR(m2(i, j), i == j ? 1 : 0, 1e-9);
+    }
+  }
+  S21Matrix m3(2, 2);
+  m3(1, 1) = 1;
+  m3(1, 2) = 2;
+  m3(2, 1) = 2;
+  m3(2, 2) = 4;
+  EXPECT_ANY_THROW(m3.Power(-1));
+  EXPECT_ANY_THROW(S21Matrix(2, 3).Power(2));
+  EXPECT_ANY_THROW(S21Matrix().Power(2));
+}
+
+TEST(S21MatrixTest, Exp) {
+  S21Matrix m1(2, 2);
+  S21Matrix m2 = m1.Exp();
+  EXPECT_DOUBLE_EQ(m2(1, 1), 1);
+  EXPECT_DOUBLE_EQ(m2(1, 2), 0);
+  EXPECT_DOUBLE_EQ(m2(2, 1), 0);
+  EXPECT_DOUBLE_EQ(m2(2, 2), 1);
+
+  m1(1, 1) = 1;
+  m1(2, 2) = 3;
+  m2 = m1.Exp();
+  EXPECT_NEAR(m2(1, 1), exp(1), 1e-12);
+  EXPECT_NEAR(m2(1, 2), 0, 1e-12);
+  EXPECT_NEAR(m2(2, 1), 0, 1e-12);
+  EXPECT_NEAR(m2(2, 2), exp(3), 1e-10);
+
+  S21Matrix m3(2, 2);
+  m3(1, 2) = -2.5;
+  m3(2, 1) = 2.5;
+  S21Matrix m4 = m3.Exp();
+  EXPECT_NEAR(m4(1, 1), cos(2.5), 1e-12);
+  EXPECT_NEAR(m4(1, 2), -sin(2.5), 1e-12);
+  EXPECT_NEAR(m4(2, 1), sin(2.5), 1e-12);
+  EXPECT_NEAR(m4(2, 2), cos(2.5), 1e-12);
+
+  S21Matrix m5(3, 3);
+  m5(1, 2) = 1;
+  m5(2, 3) = 1;
+  S21Matrix m6 = m5.Exp();
+  EXPECT_NEAR(m6(1, 2), 1, 1e-14);
+  EXPECT_NEAR(m6(1, 3), 0.5, 1e-14);
+  EXPECT_NEAR(m6(2, 3), 1, 1e-14);
+  EXPECT_ANY_THROW(S21Matrix(2, 3).Exp());
+  m5(1, 2) = INFINITY;
+  EXPECT_THROW(m5.Exp(), std::invalid_argument);
+  m5(1, 2) = NAN;
+  EXPECT_THROW(m5.Exp(), std::invalid_argument);
+}
+
+TEST(S21MatrixTest, CopyOnWrite) {
+  S21Matrix m1(5, 5);
+  m1.Fill();
+  EXPECT_FALSE(m1.get_copy_on_write());
+  m1.set_copy_on_write(true);
+  EXPECT_TRUE(m1.get_copy_on_write());
+  EXPECT_FALSE(m1.IsShared());
+  S21Matrix m2 = m1;
+  S21Matrix m3;
+  m3 = m2;
+  EXPECT_TRUE(m1.IsShared());
+  EXPECT_TRUE(m2.get_copy_on_write());
+  EXPECT_TRUE(m1 == m3);
+  const S21Matrix &view = m2;
+  EXPECT_DOUBLE_EQ(view(2, 2), 7);
+  EXPECT_TRUE(m2.IsShared());
+  m2(2, 2) = 100;
+  EXPECT_FALSE(m2.IsShared());
+  EXPECT_TRUE(m1.IsShared());
+  EXPECT_DOUBLE_EQ(m1(2, 2), 7);
+  EXPECT_DOUBLE_EQ(m2(2, 2), 100);
+  EXPECT_FALSE(m1.IsShared());
+  EXPECT_DOUBLE_EQ(m3(2, 2), 7);
+}
+
+TEST(S21MatrixTest, CopyOnWriteMutators) {
+  S21Matrix m1(5, 4);
+  m1.Fill();
+  m1.set_copy_on_write(true);
+  S21Matrix original = m1;
+  original.set_copy_on_write(false);
+  S21Matrix m2 = m1;
+  m2.SumMatrix(m1);
+  CompareMatrices(m1, original);
+  m2 = m1;
+  m2.SubMatrix(original);
+  CompareMatrices(m1, original);
+  m2 = m1;
+  m2.MulNumber(3);
+  CompareMatrices(m1, original);
+  m2 = m1;
+  m2.Fill(7);
+  CompareMatrices(m1, original);
+  m2 = m1;
+  m2.set_size(2, 2);
+  EXPECT_TRUE(m2.get_copy_on_write());
+  CompareMatrices(m1, original);
+  S21Matrix m3 = m1 * 2 + m1;
+  CompareMatrices(m1, original);
+  EXPECT_DOUBLE_EQ(m3(3, 4), 36);
+  S21Matrix m4 = m1;
+  S21Matrix m5 = std::move(m4);
+  EXPECT_TRUE(m5.IsShared());
+  EXPECT_FALSE(m4.IsShared());
+  m5.set_copy_on_write(false);
+  EXPECT_FALSE(m5.IsShared());
+  EXPECT_FALSE(m1.IsShared());
+  CompareMatrices(m5, original);
+  S21Matrix m6 = m1;
+  m6 *= S21Matrix(4, 6);
+  EXPECT_TRUE(m6.get_copy_on_write());
+  S21Matrix m7 = m6;
+  EXPECT_TRUE(m6.IsShared());
+  m7.Product(m7, S21Matrix(6, 6));
+  EXPECT_TRUE(m7.get_copy_on_write());
+  S21Matrix m8 = m7;
+  EXPECT_TRUE(m7.IsShared());
+  CompareMatrices(m1, original);
+}
+
+TEST(S21MatrixTest, CopyOnWritePower) {
+  S21Matrix m1(2, 2);
+  m1(1, 1) = 2;
+  m1(1, 2) = 1;
+  m1(2, 1) = 1;
+  m1(2, 2) = 1;
+  S21Matrix original = m1;
+  m1.set_copy_on_write(true);
+  S21Matrix m2 = m1.Power(-3);
+  S21Matrix m3 = m1.Exp();
+  CompareMatrices(m1, original);
+  EXPECT_FALSE(m1.IsShared());
+}
+
+TEST(S21MatrixTest, UncheckedAccess) {
+  S21Matrix m1(3, 4);
+  m1.Fill();
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      EXPECT_DOUBLE_EQ(m1[i][j], m1(i + 1, j + 1));
+    }
+  }
+  m1[2][3] = -1;
+  EXPECT_DOUBLE_EQ(m1(3, 4), -1);
+  const S21Matrix &view = m1;
+  EXPECT_DOUBLE_EQ(view[1][0], 5);
+  EXPECT_EQ(view.data(), view[0]);
+  EXPECT_EQ(S21Matrix().data(), nullptr);
+  EXPECT_EQ(S21Matrix().begin(), S21Matrix().end());
+  EXPECT_EQ(m1.Row(1).size(), 4);
+  EXPECT_DOUBLE_EQ(m1.Row(1)[2], 7);
+  EXPECT_DOUBLE_EQ(view.Row(2)[0], 9);
+}
+
+TEST(S21MatrixTest, ElementIterators) {
+  S21Matrix m1(3, 3);
+  m1.Fill();
+  EXPECT_EQ(std::distance(m1.begin(), m1.end()), 9);
+  EXPECT_DOUBLE_EQ(std::accumulate(m1.cbegin(), m1.cend(), 0.0), 45);
+  std::reverse(m1.begin(), m1.end());
+  EXPECT_DOUBLE_EQ(m1(1, 1), 9);
+  EXPECT_DOUBLE_EQ(m1(3, 3), 1);
+  std::sort(m1.begin(), m1.end());
+  S21Matrix m2(3, 3);
+  m2.Fill();
+  CompareMatrices(m1, m2);
+  for (double &value : m1) {
+    value *= 2;
+  }
+  EXPECT_DOUBLE_EQ(*std::max_element(m1.begin(), m1.end()), 18);
+}
+
+TEST(S21MatrixTest, RowIterators) {
+  S21Matrix m1(4, 3);
+  m1.Fill();
+  int row = 0;
+  for (auto span : m1.Rows()) {
+    EXPECT_EQ(span.size(), 3);
+    EXPECT_DOUBLE_EQ(span[0], row * 3 + 1);
+    for (double &value : span) {
+      value = -value;
+    }
+    ++row;
+  }
+  EXPECT_EQ(row, 4);
+  EXPECT_DOUBLE_EQ(m1(4, 3), -12);
+  const S21Matrix &view = m1;
+  auto rows = view.Rows();
+  EXPECT_EQ(rows.size(), 4);
+  EXPECT_EQ(rows.end() - rows.begin(), 4);
+  S21Matrix::const_row_iterator it = rows.begin();
+  EXPECT_DOUBLE_EQ((*(it + 2))[1], -8);
+  EXPECT_DOUBLE_EQ(it[3][2], -12);
+  it += 3;
+  EXPECT_TRUE(it > rows.begin());
+  EXPECT_TRUE(--it < rows.end());
+  EXPECT_EQ(std::distance(it, rows.end()), 2);
+  auto found = std::find_if(rows.begin(), rows.end(),
+                            [](auto span) { return span[0] == -7; });
+  EXPECT_EQ(found - rows.begin(), 2);
+}
+
+TEST(S21MatrixTest, IteratorsCopyOnWrite) {
+  S21Matrix m1(5, 5);
+  m1.Fill();
+  m1.set_copy_on_write(true);
+  S21Matrix m2 = m1;
+  const S21Matrix &view = m2;
+  EXPECT_DOUBLE_EQ(*view.begin(), 1);
+  EXPECT_TRUE(m2.IsShared());
+  *m2.begin() = 10;
+  EXPECT_FALSE(m2.IsShared());
+  EXPECT_DOUBLE_EQ(m1(1, 1), 1);
+  S21Matrix m3 = m1;
+  m3[1][1] = 70;
+  EXPECT_DOUBLE_EQ(m1(2, 2), 7);
+}
+
+TEST(S21MatrixTest, Stats) {
+  stats::Reset();
+  S21Matrix m1(3, 4);
+  S21Matrix m2(4, 2);
+  m1.Fill();
+  m2.Fill();
+  m1.MulMatrix(m2);
+  m1.set_size(2, 2);
+  m1.Determinant();
+  m1.SumMatrix(m1);
+  S21Matrix large(5, 4);
+  if (stats::kEnabled) {
+    EXPECT_EQ(stats::GetAllocations(), 2);
+    EXPECT_EQ(stats::GetAllocatedBytes(),
+              5 * sizeof(double *) + 20 * sizeof(double));
+    EXPECT_EQ(stats::GetCalls(stats::kMulMatrix), 1);
+    EXPECT_EQ(stats::GetFlops(stats::kMulMatrix), 48);
+    EXPECT_EQ(stats::GetCalls(stats::kDeterminant), 1);
+    EXPECT_EQ(stats::GetFlops(stats::kDeterminant), 3);
+    EXPECT_EQ(stats::GetFlops(stats::kSumMatrix), 4);
+    unsigned long long calls = 0;
+    for (auto bucket : stats::GetLatencyHistogram(stats::kMulMatrix)) {
+      calls += bucket;
+    }
+    EXPECT_EQ(calls, 1);
+  }
+  stats::Reset();
+  EXPECT_EQ(stats::GetAllocations(), 0);
+  EXPECT_EQ(stats::GetAllocatedBytes(), 0);
+  EXPECT_EQ(stats::GetCalls(stats::kMulMatrix), 0);
+  EXPECT_EQ(stats::GetFlops(stats::kMulMatrix), 0);
+  EXPECT_EQ(stats::GetCalls(stats::kOperationCount), 0);
+  for (auto bucket : stats::GetLatencyHistogram(stats::kMulMatrix)) {
+    EXPECT_EQ(bucket, 0);
+  }
+}
+
+TEST(S21MatrixTest, Product) {
+  S21Matrix lhs(3, 4);
+  S21Matrix rhs(4, 2);
+  std::iota(lhs.begin(), lhs.end(), 1.0);
+  std::iota(rhs.begin(), rhs.end(), -3.0);
+  S21Matrix result(3, 2);
+  const double *buffer = result.data();
+  result.Product(lhs, rhs);
+  EXPECT_EQ(result.data(), buffer);
+  EXPECT_TRUE(result == lhs * rhs);
+  S21Matrix other;
+  other.Product(lhs, rhs);
+  EXPECT_TRUE(other == lhs * rhs);
+  S21Matrix square(4, 4);
+  std::iota(square.begin(), square.end(), 0.5);
+  S21Matrix expected = square * square;
+  square.Product(square, square);
+  EXPECT_TRUE(square == expected);
+  EXPECT_ANY_THROW(result.Product(rhs, lhs));
+}
+
 void CompareMatrices(const S21Matrix &m1, const S21Matrix &m2) {
   EXPECT_EQ(m1.get_rows(), m2.get_rows());
   EXPECT_EQ(m1.get_cols(), m2.get_cols());
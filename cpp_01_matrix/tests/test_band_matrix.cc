@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "../s21_band_matrix.h"
+#include "../s21_parallel.h"
+
+namespace s21 {
+
+S21BandMatrix MakeBandMatrix(const int size, const int lower,
+                             const int upper) {
+  S21BandMatrix result(size, lower, upper);
+  for (int i = 1; i <= size; ++i) {
+    for (int j = std::max(1, i - lower); j <= std::min(size, i + upper); ++j) {
+      result(i, j) = i == j ? 1.0 + i % 3 : ((i * 3 + j * 5) % 7 - 3) * 0.5;
+    }
+  }
+  return result;
+}
+
+S21Matrix MakeBandRhs(const int rows, const int cols) {
+  S21Matrix result(rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      result[i][j] = (i * 3 + j * 7) % 10 - 4.5;
+    }
+  }
+  return result;
+}
+
+TEST(S21BandMatrixTest, Storage) {
+  S21Matrix source(4);
+  std::iota(source.begin(), source.end(), 1.0);
+  S21BandMatrix band(source, 1, 2);
+  const S21BandMatrix &view = band;
+  EXPECT_EQ(band.get_size(), 4);
+  EXPECT_EQ(band.get_lower(), 1);
+  EXPECT_EQ(band.get_upper(), 2);
+  EXPECT_EQ(band(2, 1), 5);
+  EXPECT_EQ(band(1, 3), 3);
+  EXPECT_EQ(view(3, 1), 0);
+  EXPECT_EQ(view(1, 4), 0);
+  EXPECT_ANY_THROW(band(3, 1) = 1);
+  EXPECT_ANY_THROW(view(5, 1));
+  S21Matrix dense = band.ToMatrix();
+  EXPECT_EQ(dense[3][3], 16);
+  EXPECT_EQ(dense[0][3], 0);
+  EXPECT_ANY_THROW(S21BandMatrix(3, -1, 0));
+  EXPECT_ANY_THROW(S21BandMatrix(S21Matrix(2, 3), 1, 1));
+}
+
+TEST(S21BandMatrixTest, Multiply) {
+  S21BandMatrix band = MakeBandMatrix(50, 3, 2);
+  S21Matrix rhs = MakeBandRhs(50, 4);
+  EXPECT_TRUE((band * rhs).ApproxEqual(band.ToMatrix() * rhs, 1e-12));
+  S21Matrix x = MakeBandRhs(50, 1);
+  S21Matrix y(50, 1);
+  band.MulVector(x.data(), y.data());
+  EXPECT_TRUE(y.ApproxEqual(band.ToMatrix() * x, 1e-12));
+  EXPECT_ANY_THROW(band * S21Matrix(3, 1));
+}
+
+TEST(S21BandMatrixTest, Solve) {
+  for (auto bandwidth : {std::pair<int, int>{1, 1}, {0, 0}, {2, 3}, {4, 1}}) {
+    S21BandMatrix band =
+        MakeBandMatrix(60, bandwidth.first, bandwidth.second);
+    S21Matrix rhs = MakeBandRhs(60, 3);
+    S21Matrix solution = band.Solve(rhs);
+    EXPECT_TRUE((band * solution).ApproxEqual(rhs, 1e-9));
+  }
+  S21BandMatrix pivoting(3, 1, 1);
+  pivoting(1, 2) = 1;
+  pivoting(2, 1) = 1;
+  pivoting(2, 3) = 2;
+  pivoting(3, 2) = 1;
+  pivoting(3, 3) = 1;
+  S21Matrix rhs = MakeBandRhs(3, 2);
+  EXPECT_TRUE((pivoting * pivoting.Solve(rhs)).ApproxEqual(rhs, 1e-12));
+  EXPECT_ANY_THROW(S21BandMatrix(3, 1, 1).Solve(rhs));
+  EXPECT_ANY_THROW(pivoting.Solve(S21Matrix(2, 1)));
+}
+
+TEST(S21BandMatrixTest, SolveTridiagonal) {
+  const int size = 40;
+  const int count = 300;
+  std::vector<double> lower(size * count);
+  std::vector<double> diagonal(size * count);
+  std::vector<double> upper(size * count);
+  std::vector<double> rhs(size * count);
+  for (int i = 0; i < size * count; ++i) {
+    lower[i] = -1.0 - i % 3 * 0.1;
+    diagonal[i] = 4.0 + i % 5;
+    upper[i] = -1.0 + i % 2 * 0.3;
+    rhs[i] = i % 11 - 5.0;
+  }
+  std::vector<double> solution = rhs;
+  parallel::SetThreadCount(4);
+  S21BandMatrix::SolveTridiagonal(size, count, lower.data(), diagonal.data(),
+                                  upper.data(), solution.data());
+  parallel::SetThreadCount(0);
+  for (int s = 0; s < count; s += 37) {
+    S21BandMatrix band(size, 1, 1);
+    for (int i = 0; i < size; ++i) {
+      band(i + 1, i + 1) = diagonal[s * size + i];
+      if (i) {
+        band(i + 1, i) = lower[s * size + i];
+      }
+      if (i + 1 < size) {
+        band(i + 1, i + 2) = upper[s * size + i];
+      }
+    }
+    std::vector<double> product(size);
+    band.MulVector(solution.data() + s * size, product.data());
+    for (int i = 0; i < size; ++i) {
+      EXPECT_NEAR(product[i], rhs[s * size + i], 1e-12);
+    }
+  }
+  diagonal[(count - 1) * size] = 0.0;
+  solution = rhs;
+  parallel::SetThreadCount(4);
+  EXPECT_ANY_THROW(S21BandMatrix::SolveTridiagonal(
+      size, count, lower.data(), diagonal.data(), upper.data(),
+      solution.data()));
+  parallel::SetThreadCount(0);
+  EXPECT_EQ(solution, rhs);
+}
+
+}  // namespace s21
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include "../s21_inverse_updater.h"
+
+namespace s21 {
+
+S21Matrix MakeUpdaterMatrix(const int size) {
+  S21Matrix result(size, size);
+  for (int i = 0; i < size; ++i) {
+    for (int j = 0; j < size; ++j) {
+      result[i][j] = ((i * 5 + j * 3) % 7) - 3.0 + (i == j ? size : 0);
+    }
+  }
+  return result;
+}
+
+void CheckUpdater(const S21InverseUpdater &updater) {
+  const S21Matrix &matrix = updater.get_matrix();
+  S21Matrix identity = matrix * updater.get_inverse();
+  const int size = matrix.get_rows();
+  for (int i = 0; i < size; ++i) {
+    for (int j = 0; j < size; ++j) {
+      EXPECT_NEAR(identity[i][j], i == j ? 1 : 0, 1e-9);
+    }
+  }
+  EXPECT_NEAR(updater.get_determinant() / matrix.Determinant(), 1, 1e-9);
+}
+
+TEST(S21InverseUpdaterTest, Create) {
+  EXPECT_ANY_THROW(S21InverseUpdater{S21Matrix(2, 3)});
+  EXPECT_ANY_THROW(S21InverseUpdater{S21Matrix(3, 3)});
+  S21InverseUpdater updater(MakeUpdaterMatrix(6));
+  EXPECT_EQ(updater.get_refactorizations(), 0);
+  CheckUpdater(updater);
+}
+
+TEST(S21InverseUpdaterTest, RankOne) {
+  S21InverseUpdater updater(MakeUpdaterMatrix(8));
+  S21Matrix u(8, 1);
+  S21Matrix v(1, 8);
+  u.Fill();
+  v.Fill(3);
+  v.MulNumber(0.01);
+  updater.RankOneUpdate(u, v);
+  S21Matrix expected = MakeUpdaterMatrix(8) + u * v;
+  EXPECT_TRUE(updater.get_matrix().ApproxEqual(expected, 1e-12));
+  EXPECT_EQ(updater.get_refactorizations(), 0);
+  CheckUpdater(updater);
+  EXPECT_ANY_THROW(updater.RankOneUpdate(u, S21Matrix(7, 1)));
+  EXPECT_ANY_THROW(updater.RankOneUpdate(S21Matrix(8, 2), v));
+}
+
+TEST(S21InverseUpdaterTest, ReplaceRowAndColumn) {
+  S21InverseUpdater updater(MakeUpdaterMatrix(7));
+  S21Matrix values(1, 7);
+  for (int step = 0; step < 20; ++step) {
+    for (int j = 0; j < 7; ++j) {
+      values[0][j] = (step * 3 + j) % 5 - 2.0 + (j == step % 7 ? 9 : 0);
+    }
+    updater.ReplaceRow(step % 7 + 1, values);
+    EXPECT_DOUBLE_EQ(updater.get_matrix()[step % 7][3], values[0][3]);
+    CheckUpdater(updater);
+    updater.ReplaceColumn((step * 2) % 7 + 1, values.Transpose());
+    EXPECT_DOUBLE_EQ(updater.get_matrix()[4][(step * 2) % 7], values[0][4]);
+    CheckUpdater(updater);
+  }
+  EXPECT_ANY_THROW(updater.ReplaceRow(0, values));
+  EXPECT_ANY_THROW(updater.ReplaceColumn(8, values));
+}
+
+TEST(S21InverseUpdaterTest, Refactorization) {
+  S21Matrix matrix(3, 3);
+  matrix[0][0] = matrix[1][1] = matrix[2][2] = 1;
+  S21InverseUpdater updater(matrix);
+  S21Matrix values(1, 3);
+  values[0][0] = 1;
+  values[0][1] = 1e-12;
+  updater.ReplaceRow(2, values);
+  EXPECT_EQ(updater.get_refactorizations(), 1);
+  CheckUpdater(updater);
+  values[0][1] = 0;
+  const S21Matrix before = updater.get_matrix();
+  EXPECT_ANY_THROW(updater.ReplaceRow(2, values));
+  EXPECT_TRUE(updater.get_matrix() == before);
+  CheckUpdater(updater);
+}
+
+TEST(S21InverseUpdaterTest, RankK) {
+  S21InverseUpdater updater(MakeUpdaterMatrix(9));
+  S21Matrix u(9, 3);
+  S21Matrix v(9, 3);
+  for (int i = 0; i < 9; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      u[i][j] = (i + j) % 4 - 1.5;
+      v[i][j] = (i * j) % 3 * 0.25;
+    }
+  }
+  updater.RankUpdate(u, v);
+  S21Matrix expected = MakeUpdaterMatrix(9) + u * v.Transpose();
+  EXPECT_TRUE(updater.get_matrix().ApproxEqual(expected, 1e-12));
+  EXPECT_EQ(updater.get_refactorizations(), 0);
+  CheckUpdater(updater);
+  EXPECT_ANY_THROW(updater.RankUpdate(u, S21Matrix(9, 2)));
+  EXPECT_ANY_THROW(updater.RankUpdate(S21Matrix(8, 3), v));
+}
+
+}  // namespace s21
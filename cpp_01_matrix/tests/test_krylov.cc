@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include <type_traits>
+#include <vector>
+
+#include "../s21_krylov.h"
+#include "../s21_parallel.h"
+
+namespace s21 {
+
+static_assert(!std::is_constructible_v<S21LinearOperator, S21Matrix>,
+              "a dense operator must not bind to a temporary matrix");
+
+// Five-point Laplacian on a grid x grid mesh, symmetric positive definite.
+S21Matrix MakeLaplacian(const int grid) {
+  const int size = grid * grid;
+  S21Matrix result(size);
+  for (int i = 0; i < size; ++i) {
+    result[i][i] = 4.0;
+    if (i % grid) {
+      result[i][i - 1] = -1.0;
+    }
+    if ((i + 1) % grid) {
+      result[i][i + 1] = -1.0;
+    }
+    if (i >= grid) {
+      result[i][i - grid] = -1.0;
+    }
+    if (i + grid < size) {
+      result[i][i + grid] = -1.0;
+    }
+  }
+  return result;
+}
+
+// Convection-diffusion: the Laplacian plus a nonsymmetric first-order term.
+S21Matrix MakeConvection(const int grid) {
+  S21Matrix result = MakeLaplacian(grid);
+  for (int i = 1; i < result.get_rows(); ++i) {
+    if (result[i][i - 1]) {
+      result[i][i - 1] -= 0.4;
+      result[i - 1][i] += 0.4;
+    }
+  }
+  return result;
+}
+
+S21Matrix MakeKrylovRhs(const int size) {
+  S21Matrix result(size, 1);
+  for (int i = 0; i < size; ++i) {
+    result[i][0] = (i * 7) % 5 - 2.0;
+  }
+  return result;
+}
+
+void CheckKrylov(const S21Matrix &matrix, S21KrylovSolver &solver) {
+  S21Matrix rhs = MakeKrylovRhs(matrix.get_rows());
+  S21Matrix solution = solver.Solve(rhs);
+  EXPECT_LE(solver.get_residual(), 1e-10);
+  EXPECT_GT(solver.get_iterations(), 0);
+  EXPECT_TRUE((matrix * solution).ApproxEqual(rhs, 1e-8));
+}
+
+TEST(S21KrylovTest, ConjugateGradient) {
+  S21Matrix matrix = MakeLaplacian(12);
+  S21LinearOperator op(matrix);
+  S21KrylovSolver solver(op, S21KrylovSolver::kCG);
+  CheckKrylov(matrix, solver);
+  const int plain = solver.get_iterations();
+  solver.set_preconditioner(S21LinearOperator::ILU0(matrix));
+  CheckKrylov(matrix, solver);
+  EXPECT_LT(solver.get_iterations(), plain);
+  solver.set_preconditioner(S21LinearOperator::Jacobi(matrix));
+  CheckKrylov(matrix, solver);
+}
+
+TEST(S21KrylovTest, BiCGSTAB) {
+  S21Matrix matrix = MakeConvection(10);
+  S21KrylovSolver solver(S21LinearOperator(matrix), S21KrylovSolver::kBiCGSTAB);
+  CheckKrylov(matrix, solver);
+  solver.set_preconditioner(S21LinearOperator::ILU0(matrix));
+  CheckKrylov(matrix, solver);
+}
+
+TEST(S21KrylovTest, GMRES) {
+  S21Matrix matrix = MakeConvection(10);
+  S21KrylovSolver solver{S21LinearOperator(matrix)};
+  solver.set_restart(10);
+  CheckKrylov(matrix, solver);
+  const int plain = solver.get_iterations();
+  solver.set_preconditioner(S21LinearOperator::ILU0(matrix));
+  CheckKrylov(matrix, solver);
+  EXPECT_LT(solver.get_iterations(), plain);
+  parallel::SetThreadCount(3);
+  solver.set_preconditioner(S21LinearOperator::Jacobi(matrix));
+  CheckKrylov(matrix, solver);
+  parallel::SetThreadCount(0);
+}
+
+TEST(S21KrylovTest, MatrixFree) {
+  const int size = 500;
+  S21LinearOperator op(size, [size](const double *x, double *y) {
+    for (int i = 0; i < size; ++i) {
+      y[i] = 3.0 * x[i] - (i ? x[i - 1] : 0.0) -
+             (i + 1 < size ? x[i + 1] : 0.0);
+    }
+  });
+  std::vector<double> rhs(size, 1.0);
+  std::vector<double> solution(size, 0.0);
+  std::vector<double> check(size);
+  for (auto method : {S21KrylovSolver::kCG, S21KrylovSolver::kBiCGSTAB,
+                      S21KrylovSolver::kGMRES}) {
+    S21KrylovSolver solver(op, method);
+    std::fill(solution.begin(), solution.end(), 0.0);
+    EXPECT_TRUE(solver.Solve(rhs.data(), solution.data()));
+    op.Apply(solution.data(), check.data());
+    for (int i = 0; i < size; ++i) {
+      EXPECT_NEAR(check[i], 1.0, 1e-8);
+    }
+  }
+}
+
+TEST(S21KrylovTest, Errors) {
+  S21Matrix matrix = MakeLaplacian(3);
+  S21KrylovSolver solver(S21LinearOperator(matrix), S21KrylovSolver::kCG);
+  EXPECT_ANY_THROW(solver.set_tolerance(0));
+  EXPECT_ANY_THROW(solver.set_max_iterations(0));
+  EXPECT_ANY_THROW(solver.set_restart(0));
+  EXPECT_ANY_THROW(solver.set_preconditioner(S21LinearOperator::Identity(2)));
+  EXPECT_ANY_THROW(solver.Solve(S21Matrix(8, 1)));
+  const S21Matrix rectangular(2, 3);
+  EXPECT_ANY_THROW(S21LinearOperator{rectangular});
+  EXPECT_ANY_THROW(S21LinearOperator::Jacobi(S21Matrix(2)));
+  EXPECT_ANY_THROW(S21LinearOperator::ILU0(S21Matrix(2)));
+  solver.set_max_iterations(1);
+  EXPECT_THROW(solver.Solve(MakeKrylovRhs(9)), std::runtime_error);
+  S21Matrix zero = solver.Solve(S21Matrix(9, 1));
+  EXPECT_EQ(zero.NormInf(), 0);
+}
+
+}  // namespace s21
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+
+#include "../s21_lu.h"
+#include "../s21_parallel.h"
+
+namespace s21 {
+
+S21Matrix MakeLUMatrix(const int size) {
+  S21Matrix result(size, size);
+  for (int i = 0; i < size; ++i) {
+    for (int j = 0; j < size; ++j) {
+      result[i][j] = ((i * 37 + j * 101) % 23) / 7.0 - 1.5 + (i == j ? 2 : 0);
+    }
+  }
+  return result;
+}
+
+void CheckFactorization(const S21Matrix &matrix, const S21LU &lu) {
+  const int size = matrix.get_rows();
+  S21Matrix permuted{matrix};
+  for (int i = 0; i < size; ++i) {
+    const int pivot = lu.get_pivots()[i];
+    for (int j = 0; j < size; ++j) {
+      std::swap(permuted[i][j], permuted[pivot][j]);
+    }
+  }
+  const S21Matrix &factors = lu.get_factors();
+  for (int i = 0; i < size; ++i) {
+    for (int j = 0; j < size; ++j) {
+      double value = 0.0;
+      for (int k = 0; k <= std::min(i, j); ++k) {
+        value += (k == i ? 1.0 : factors[i][k]) * factors[k][j];
+      }
+      EXPECT_NEAR(value, permuted[i][j], 1e-9);
+    }
+  }
+}
+
+TEST(S21LUTest, Errors) {
+  EXPECT_ANY_THROW(S21LU{S21Matrix()});
+  EXPECT_ANY_THROW(S21LU{S21Matrix(2, 3)});
+  S21LU lu(S21Matrix(3, 3));
+  EXPECT_TRUE(lu.IsSingular());
+  EXPECT_DOUBLE_EQ(lu.Determinant(), 0);
+  EXPECT_ANY_THROW(lu.Inverse());
+  EXPECT_ANY_THROW(S21LU(MakeLUMatrix(3)).Solve(S21Matrix(2, 1)));
+}
+
+TEST(S21LUTest, Factorization) {
+  for (int size : {1, 2, 5, 17, 70}) {
+    S21Matrix matrix = MakeLUMatrix(size);
+    for (int block : {1, 4, 16, 64}) {
+      S21LU lu(matrix, block);
+      EXPECT_FALSE(lu.IsSingular());
+      CheckFactorization(matrix, lu);
+    }
+  }
+}
+
+TEST(S21LUTest, Threads) {
+  S21Matrix matrix = MakeLUMatrix(150);
+  S21LU serial(matrix, 16);
+  parallel::SetThreadCount(4);
+  S21LU threaded(matrix, 16);
+  parallel::SetThreadCount(0);
+  CheckFactorization(matrix, threaded);
+  EXPECT_EQ(serial.get_pivots(), threaded.get_pivots());
+  EXPECT_TRUE(serial.get_factors() == threaded.get_factors());
+}
+
+TEST(S21LUTest, Determinant) {
+  S21Matrix matrix(5, 5);
+  matrix.Fill();
+  EXPECT_NEAR(S21LU(matrix).Determinant(), 0, 1e-9);
+  for (int i = 0; i < 5; ++i) {
+    matrix[i][i] += 10 * (i + 1);
+  }
+  S21Matrix small(4, 4);
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      small[i][j] = matrix[i][j];
+    }
+  }
+  EXPECT_NEAR(S21LU(small).Determinant(), small.Determinant(), 1e-8);
+  EXPECT_NEAR(matrix.Determinant(), 28750000, 1e-5);
+  S21Matrix swapped{matrix};
+  for (int j = 0; j < 5; ++j) {
+    std::swap(swapped[0][j], swapped[3][j]);
+  }
+  EXPECT_NEAR(swapped.Determinant(), -28750000, 1e-5);
+}
+
+TEST(S21LUTest, SolveAndInverse) {
+  for (int size : {3, 6, 40}) {
+    S21Matrix matrix = MakeLUMatrix(size);
+    S21Matrix rhs(size, 3);
+    rhs.Fill();
+    S21Matrix solution = S21LU(matrix, 8).Solve(rhs);
+    S21Matrix residual = matrix * solution - rhs;
+    for (double value : static_cast<const S21Matrix &>(residual)) {
+      EXPECT_NEAR(value, 0, 1e-9);
+    }
+    S21Matrix identity = matrix * matrix.InverseMatrix();
+    for (int i = 0; i < size; ++i) {
+      for (int j = 0; j < size; ++j) {
+        EXPECT_NEAR(identity[i][j], i == j ? 1 : 0, 1e-9);
+      }
+    }
+  }
+  S21Matrix singular(6, 6);
+  singular.Fill();
+  for (int j = 0; j < 6; ++j) {
+    singular[5][j] = singular[4][j];
+  }
+  EXPECT_ANY_THROW(singular.InverseMatrix());
+}
+
+TEST(S21LUTest, RoundedSingular) {
+  for (int size : {5, 8, 9, 30}) {
+    S21Matrix matrix(size, size);
+    matrix.Fill();
+    EXPECT_TRUE(S21LU(matrix).IsSingular());
+    EXPECT_DOUBLE_EQ(matrix.Determinant(), 0);
+    EXPECT_THROW(matrix.InverseMatrix(), std::logic_error);
+    matrix.MulNumber(1e-200);
+    EXPECT_TRUE(S21LU(matrix).IsSingular());
+    EXPECT_FALSE(S21LU(MakeLUMatrix(size) * 1e-200).IsSingular());
+  }
+}
+
+TEST(S21LUTest, CopyAndMove) {
+  for (int size : {3, 40}) {
+    const S21Matrix matrix = MakeLUMatrix(size);
+    auto lu = std::make_unique<S21LU>(matrix);
+    const double determinant = lu->Determinant();
+    S21LU copy(*lu);
+    S21LU moved(std::move(*lu));
+    lu.reset();
+    EXPECT_DOUBLE_EQ(copy.Determinant(), determinant);
+    EXPECT_DOUBLE_EQ(moved.Determinant(), determinant);
+    CheckFactorization(matrix, copy);
+    CheckFactorization(matrix, moved);
+    S21LU assigned(MakeLUMatrix(2));
+    assigned = copy;
+    EXPECT_DOUBLE_EQ(assigned.Determinant(), determinant);
+    copy = std::move(moved);
+    EXPECT_DOUBLE_EQ(copy.Determinant(), determinant);
+    EXPECT_TRUE(copy.Inverse().ApproxEqual(assigned.Inverse(), 0, 1e-12));
+  }
+}
+
+}  // namespace s21
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include <type_traits>
+#include <utility>
+
+#include "../s21_matrix_chain.h"
+#include "../s21_parallel.h"
+
+namespace s21 {
+
+template <typename T, typename = void>
+struct CanAppend : std::false_type {};
+
+template <typename T>
+struct CanAppend<T, std::void_t<decltype(std::declval<S21MatrixChain &>() *=
+                                         std::declval<T>())>>
+    : std::true_type {};
+
+S21Matrix MakeChainMatrix(const int rows, const int cols, const int seed) {
+  S21Matrix result(rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      result[i][j] = ((i * 7 + j * 3 + seed) % 11) * 0.125 - 0.5;
+    }
+  }
+  return result;
+}
+
+TEST(S21MatrixChainTest, Order) {
+  S21Matrix a(100, 2);
+  S21Matrix b(2, 100);
+  S21Matrix c(100, 2);
+  S21MatrixChain chain{a, b, c};
+  EXPECT_EQ(chain.get_size(), 3);
+  EXPECT_EQ(chain.Order(), "(A1*(A2*A3))");
+  EXPECT_DOUBLE_EQ(chain.Cost(), 2 * 100 * 2 + 100 * 2 * 2);
+  S21MatrixChain reversed{b, c, b};
+  EXPECT_EQ(reversed.Order(), "((A1*A2)*A3)");
+  S21MatrixChain single{a};
+  EXPECT_EQ(single.Order(), "A1");
+  EXPECT_DOUBLE_EQ(single.Cost(), 0);
+}
+
+TEST(S21MatrixChainTest, Evaluate) {
+  const int dims[] = {7, 30, 3, 25, 4, 18, 9};
+  std::vector<S21Matrix> matrices;
+  for (int i = 0; i < 6; ++i) {
+    matrices.push_back(MakeChainMatrix(dims[i], dims[i + 1], i));
+  }
+  S21MatrixChain chain;
+  S21Matrix expected = matrices[0];
+  chain *= matrices[0];
+  for (int i = 1; i < 6; ++i) {
+    chain *= matrices[i];
+    expected *= matrices[i];
+  }
+  EXPECT_TRUE(chain.Evaluate().ApproxEqual(expected, 1e-10));
+  parallel::SetThreadCount(4);
+  EXPECT_TRUE(chain.Evaluate().ApproxEqual(expected, 1e-10));
+  parallel::SetThreadCount(0);
+  S21MatrixChain single{matrices[2]};
+  EXPECT_TRUE(single.Evaluate() == matrices[2]);
+}
+
+TEST(S21MatrixChainTest, Errors) {
+  S21Matrix a(2, 3);
+  S21Matrix b(4, 2);
+  S21MatrixChain chain{a};
+  EXPECT_ANY_THROW(chain *= b);
+  EXPECT_EQ(chain.get_size(), 1);
+  S21MatrixChain empty;
+  EXPECT_ANY_THROW(empty.Evaluate());
+  EXPECT_ANY_THROW(empty.Cost());
+  EXPECT_ANY_THROW(empty.Order());
+  static_assert(CanAppend<S21Matrix &>::value);
+  static_assert(CanAppend<const S21Matrix &>::value);
+  static_assert(!CanAppend<S21Matrix>::value);
+}
+
+}  // namespace s21
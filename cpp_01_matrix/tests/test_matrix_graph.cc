@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+#include "../s21_matrix_graph.h"
+#include "../s21_parallel.h"
+
+namespace s21 {
+
+S21Matrix MakeGraphMatrix(const int size, const int seed) {
+  S21Matrix result(size, size);
+  for (int i = 0; i < size; ++i) {
+    for (int j = 0; j < size; ++j) {
+      result[i][j] = ((i * 5 + j * 3 + seed) % 7) * 0.25 + (i == j) * size;
+    }
+  }
+  return result;
+}
+
+TEST(S21MatrixGraphTest, Pipeline) {
+  const S21Matrix a = MakeGraphMatrix(12, 1);
+  const S21Matrix b = MakeGraphMatrix(12, 2);
+  const S21Matrix c = MakeGraphMatrix(12, 3);
+  const S21Matrix expected = (a * b + a * c.Transpose() * 0.5).InverseMatrix();
+  for (int threads : {1, 4}) {
+    parallel::SetThreadCount(threads);
+    S21MatrixGraph graph;
+    const auto in_a = graph.Input(a);
+    const auto ab = graph.Mul(in_a, graph.Input(b));
+    const auto act = graph.Mul(in_a, graph.Transpose(graph.Input(c)));
+    const auto half = graph.MulNumber(act, 0.5);
+    const auto inverse = graph.Inverse(graph.Sum(ab, half));
+    graph.Keep(act);
+    EXPECT_EQ(graph.get_size(), 9);
+    EXPECT_TRUE(in_a.IsReady());
+    EXPECT_FALSE(inverse.IsReady());
+    EXPECT_TRUE(inverse.Get().ApproxEqual(expected, 1e-12));
+    EXPECT_TRUE(ab.IsReady());
+    EXPECT_THROW(ab.Get(), std::logic_error);
+    EXPECT_THROW(graph.Transpose(half), std::logic_error);
+    EXPECT_TRUE(act.Get().ApproxEqual(a * c.Transpose(), 1e-12));
+    EXPECT_TRUE(&in_a.Get() == &a);
+    const auto product = graph.Mul(inverse, graph.Sub(act, graph.Input(b)));
+    graph.Run();
+    EXPECT_TRUE(product.Get().ApproxEqual(
+        expected * (a * c.Transpose() - b), 1e-12));
+    EXPECT_TRUE(inverse.Get().ApproxEqual(expected, 1e-12));
+  }
+  parallel::SetThreadCount(0);
+}
+
+TEST(S21MatrixGraphTest, IndependentNodes) {
+  parallel::SetThreadCount(4);
+  S21MatrixGraph graph;
+  std::atomic<int> calls{0};
+  std::vector<S21MatrixGraph::Handle> outputs;
+  for (int i = 0; i < 64; ++i) {
+    auto node = graph.Schedule({}, [i, &calls](const auto &) {
+      ++calls;
+      S21Matrix result(3, 3);
+      result(1, 1) = i;
+      return result;
+    });
+    for (int step = 0; step < 4; ++step) {
+      node = graph.MulNumber(node, 2);
+    }
+    outputs.push_back(graph.Sum(node, node));
+  }
+  graph.Run();
+  graph.Run();
+  EXPECT_EQ(calls, 64);
+  for (int i = 0; i < 64; ++i) {
+    EXPECT_TRUE(outputs[i].IsReady());
+    EXPECT_DOUBLE_EQ(outputs[i].Get()(1, 1), 32 * i);
+  }
+  parallel::SetThreadCount(0);
+}
+
+TEST(S21MatrixGraphTest, Errors) {
+  S21MatrixGraph graph;
+  S21MatrixGraph other;
+  const S21Matrix a(2, 3);
+  const auto input = graph.Input(a);
+  EXPECT_THROW(S21MatrixGraph::Handle().Get(), std::logic_error);
+  EXPECT_THROW(other.Transpose(input), std::logic_error);
+  EXPECT_THROW(other.Keep(input), std::logic_error);
+  const auto product = graph.Mul(input, input);
+  parallel::SetThreadCount(2);
+  EXPECT_THROW(graph.Run(), std::logic_error);
+  EXPECT_FALSE(product.IsReady());
+  EXPECT_THROW(product.Get(), std::logic_error);
+  EXPECT_THROW(graph.Run(), std::logic_error);
+  parallel::SetThreadCount(0);
+}
+
+TEST(S21MatrixGraphTest, ConcurrentGet) {
+  parallel::SetThreadCount(2);
+  for (int trial = 0; trial < 50; ++trial) {
+    S21MatrixGraph graph;
+    std::atomic<int> calls{0};
+    const auto node = graph.Schedule({}, [&calls](const auto &) {
+      ++calls;
+      S21Matrix result(4, 4);
+      result.FillIdentity();
+      return result;
+    });
+    const auto doubled = graph.MulNumber(node, 2);
+    const S21Matrix *results[2] = {nullptr, nullptr};
+    std::thread other([&] { results[1] = &doubled.Get(); });
+    results[0] = &doubled.Get();
+    other.join();
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(results[0], results[1]);
+    EXPECT_DOUBLE_EQ((*results[0])(4, 4), 2);
+    EXPECT_TRUE(node.IsReady());
+  }
+  parallel::SetThreadCount(0);
+}
+
+TEST(S21MatrixGraphTest, RunAfterFailure) {
+  const S21Matrix a = MakeGraphMatrix(5, 1);
+  S21MatrixGraph graph;
+  const auto product = graph.Mul(graph.Input(a), graph.Input(a));
+  std::atomic<int> attempts{0};
+  const auto flaky = graph.Schedule({product}, [&attempts](const auto &args) {
+    if (!attempts++) {
+      throw std::runtime_error("flaky");
+    }
+    return *args[0];
+  });
+  EXPECT_THROW(graph.Run(), std::runtime_error);
+  EXPECT_TRUE(product.IsReady());
+  const auto twice = graph.MulNumber(product, 2);
+  graph.Run();
+  EXPECT_TRUE(flaky.Get() == a * a);
+  EXPECT_TRUE(twice.Get().ApproxEqual(a * a * 2, 1e-12));
+  EXPECT_TRUE(product.Get() == a * a);
+}
+
+}  // namespace s21
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "../s21_parallel.h"
+#include "../s21_quantized_matrix.h"
+
+namespace s21 {
+
+TEST(S21QuantizedMatrixTest, Quantize) {
+  S21Matrix matrix(5, 7);
+  matrix.FillRandom(3, S21Matrix::kNormal);
+  matrix[2][3] = 10.0;
+  for (int j = 0; j < 7; ++j) {
+    matrix[4][j] = 0.0;
+  }
+  for (S21QuantizedMatrix::Axis axis :
+       {S21QuantizedMatrix::kPerRow, S21QuantizedMatrix::kPerColumn}) {
+    const S21QuantizedMatrix quantized(matrix, axis);
+    EXPECT_EQ(quantized.get_rows(), 5);
+    EXPECT_EQ(quantized.get_cols(), 7);
+    EXPECT_EQ(quantized.get_axis(), axis);
+    const auto &scales = quantized.get_scales();
+    EXPECT_EQ(scales.size(), axis == S21QuantizedMatrix::kPerRow ? 5u : 7u);
+    EXPECT_DOUBLE_EQ(quantized(3, 4), 10.0);
+    for (int i = 0; i < 5; ++i) {
+      for (int j = 0; j < 7; ++j) {
+        const double scale =
+            scales[axis == S21QuantizedMatrix::kPerRow ? i : j];
+        EXPECT_NEAR(quantized(i + 1, j + 1), matrix[i][j], scale / 2 + 1e-15);
+      }
+    }
+    EXPECT_TRUE(quantized.ToMatrix().ApproxEqual(matrix, 10.0 / 254 + 1e-15));
+    EXPECT_THROW(quantized(0, 1), std::logic_error);
+    EXPECT_THROW(quantized(6, 1), std::logic_error);
+    EXPECT_THROW(quantized(1, 8), std::logic_error);
+  }
+  EXPECT_DOUBLE_EQ(S21QuantizedMatrix(matrix).get_scales()[4], 0.0);
+  EXPECT_EQ(S21QuantizedMatrix().get_rows(), 0);
+}
+
+TEST(S21QuantizedMatrixTest, Multiply) {
+  S21Matrix lhs(37, 70);
+  S21Matrix rhs(70, 45);
+  lhs.FillRandom(1, S21Matrix::kUniform, -1.0, 2.0);
+  rhs.FillRandom(2, S21Matrix::kNormal);
+  const S21QuantizedMatrix a(lhs);
+  const S21QuantizedMatrix b(rhs, S21QuantizedMatrix::kPerColumn);
+  const S21Matrix expected = a.ToMatrix() * b.ToMatrix();
+  const S21QuantizedMatrix::Kernel supported =
+      S21QuantizedMatrix::SupportedKernel();
+  EXPECT_EQ(S21QuantizedMatrix::GetKernel(), supported);
+  S21Matrix reference;
+  for (S21QuantizedMatrix::Kernel kernel :
+       {S21QuantizedMatrix::kGeneric, S21QuantizedMatrix::kAVX2,
+        S21QuantizedMatrix::kVNNI}) {
+    S21QuantizedMatrix::SetKernel(kernel);
+    EXPECT_EQ(S21QuantizedMatrix::GetKernel(), std::min(kernel, supported));
+    parallel::SetThreadCount(3);
+    const S21Matrix result = a * b;
+    parallel::SetThreadCount(0);
+    EXPECT_TRUE(result.ApproxEqual(expected, 0, 1e-12));
+    if (kernel == S21QuantizedMatrix::kGeneric) {
+      reference = result;
+    }
+    EXPECT_TRUE(result == reference);
+  }
+  S21QuantizedMatrix::SetKernel(supported);
+  const S21Matrix exact = lhs * rhs;
+  S21Matrix error = a * b - exact;
+  EXPECT_LT(error.NormFrobenius(), 0.02 * exact.NormFrobenius());
+}
+
+TEST(S21QuantizedMatrixTest, Errors) {
+  const S21QuantizedMatrix rows(S21Matrix(3, 4));
+  const S21QuantizedMatrix columns(S21Matrix(4, 2),
+                                   S21QuantizedMatrix::kPerColumn);
+  EXPECT_EQ((rows * columns).get_cols(), 2);
+  EXPECT_THROW(rows * rows, std::logic_error);
+  EXPECT_THROW(columns * columns, std::logic_error);
+  EXPECT_THROW(
+      rows * S21QuantizedMatrix(S21Matrix(3, 2), S21QuantizedMatrix::kPerColumn),
+      std::logic_error);
+}
+
+}  // namespace s21
@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+
+#include "../s21_random.h"
+#include "../s21_simd.h"
+
+namespace s21 {
+
+// Known-answer vectors from the Random123 distribution.
+TEST(S21RandomTest, PhiloxKnownAnswers) {
+  const random::Block<uint64_t> zero =
+      random::Philox(random::Block<uint64_t>{{0, 0, 0, 0}}, 0, 0);
+  EXPECT_EQ(zero.words[0], 0x6627e8d5u);
+  EXPECT_EQ(zero.words[1], 0xe169c58du);
+  EXPECT_EQ(zero.words[2], 0xbc57ac4cu);
+  EXPECT_EQ(zero.words[3], 0x9b00dbd8u);
+  const random::Block<uint64_t> ones = random::Philox(
+      random::Block<uint64_t>{
+          {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}},
+      0xffffffff, 0xffffffff);
+  EXPECT_EQ(ones.words[0], 0x408f276du);
+  EXPECT_EQ(ones.words[1], 0x41c83b0eu);
+  EXPECT_EQ(ones.words[2], 0xa20bc7c6u);
+  EXPECT_EQ(ones.words[3], 0x6d5451fdu);
+  const random::Block<uint64_t> pi = random::Philox(
+      random::Block<uint64_t>{{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}},
+      0xa4093822, 0x299f31d0);
+  EXPECT_EQ(pi.words[0], 0xd16cfe09u);
+  EXPECT_EQ(pi.words[1], 0x94fdccebu);
+  EXPECT_EQ(pi.words[2], 0x5001e420u);
+  EXPECT_EQ(pi.words[3], 0x24126ea1u);
+}
+
+TEST(S21RandomTest, VectorLanes) {
+  constexpr uint64_t kSeed = 0x123456789abcdefULL;
+  const auto lanes = random::Generate(simd::Uint2{7, 0x100000003ULL}, kSeed);
+  const auto low = random::Generate<uint64_t>(7, kSeed);
+  const auto high = random::Generate<uint64_t>(0x100000003ULL, kSeed);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(lanes.words[i][0], low.words[i]);
+    EXPECT_EQ(lanes.words[i][1], high.words[i]);
+  }
+  static_assert(random::Generate<uint64_t>(1, 2).words[0] != 0,
+                "Philox is usable in constant expressions");
+}
+
+}  // namespace s21
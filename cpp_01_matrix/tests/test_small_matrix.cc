@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+
+#include "../s21_lu.h"
+#include "../s21_small_matrix.h"
+
+namespace s21 {
+
+constexpr small::Square<3> kSmallMatrix{2, -3, 1, 2, 0, -1, 1, 4, 5};
+static_assert(small::Determinant<3>(kSmallMatrix) == 49);
+static_assert(small::Complements<3>(kSmallMatrix)[1] == -11);
+static_assert(small::Inverse<2>({2, 1, 1, 1})[3] == 2);
+static_assert(small::Determinant<4>({1, 2, 3, 4, 0, 1, 2, 3, 0, 0, 1, 2, 0, 0,
+                                     0, 5}) == 5);
+
+S21Matrix MakeSmallMatrix(const int size) {
+  S21Matrix result(size);
+  for (int i = 0; i < size; ++i) {
+    for (int j = 0; j < size; ++j) {
+      result[i][j] = ((i * 7 + j * 5) % 9) - 4.0 + (i == j ? 5 * size : 0);
+    }
+  }
+  return result;
+}
+
+TEST(S21SmallMatrixTest, MatchesLU) {
+  for (int size = 1; size <= 4; ++size) {
+    S21Matrix matrix = MakeSmallMatrix(size);
+    EXPECT_NEAR(matrix.Determinant(), S21LU(matrix).Determinant(), 1e-9);
+    if (size > 1) {
+      EXPECT_TRUE(
+          matrix.InverseMatrix().ApproxEqual(S21LU(matrix).Inverse(), 1e-12));
+      S21Matrix adjugate = S21LU(matrix).Inverse();
+      adjugate.MulNumber(matrix.Determinant());
+      EXPECT_TRUE(
+          matrix.CalcComplements().Transpose().ApproxEqual(adjugate, 1e-9));
+    }
+  }
+}
+
+TEST(S21SmallMatrixTest, Singular) {
+  S21Matrix matrix(4);
+  std::fill(matrix.begin(), matrix.end(), 1.0);
+  EXPECT_EQ(matrix.Determinant(), 0);
+  EXPECT_ANY_THROW(matrix.InverseMatrix());
+  S21Matrix complements = matrix.CalcComplements();
+  for (double value : complements) {
+    EXPECT_EQ(value, 0);
+  }
+}
+
+}  // namespace s21
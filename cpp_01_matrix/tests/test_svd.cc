@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "../s21_parallel.h"
+#include "../s21_svd.h"
+
+namespace s21 {
+
+S21Matrix MakeSvdMatrix(const int rows, const int cols) {
+  S21Matrix result(rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      result[i][j] = ((i * 7 + j * 13) % 17 - 8) * 0.125 + (i == j) * 2.0;
+    }
+  }
+  return result;
+}
+
+S21Matrix MakeLowRankMatrix(const int rows, const int cols, const int rank) {
+  S21Matrix left(rows, rank);
+  S21Matrix right(rank, cols);
+  for (int k = 0; k < rank; ++k) {
+    for (int i = 0; i < rows; ++i) {
+      left[i][k] = sin(i * (k + 1) * 0.37) * (rank - k);
+    }
+    for (int j = 0; j < cols; ++j) {
+      right[k][j] = cos(j * (k + 2) * 0.21 + k);
+    }
+  }
+  return left * right;
+}
+
+void CheckOrthonormalColumns(const S21Matrix &matrix) {
+  S21Matrix gram = matrix.Transpose() * matrix;
+  S21Matrix identity(gram.get_rows());
+  for (int i = 0; i < identity.get_rows(); ++i) {
+    identity[i][i] = 1.0;
+  }
+  EXPECT_TRUE(gram.ApproxEqual(identity, 1e-10));
+}
+
+void CheckSvd(const S21Matrix &matrix) {
+  S21SVD svd(matrix);
+  const int rank = std::min(matrix.get_rows(), matrix.get_cols());
+  const std::vector<double> &values = svd.get_singular_values();
+  ASSERT_EQ(static_cast<int>(values.size()), rank);
+  EXPECT_EQ(svd.get_u().get_rows(), matrix.get_rows());
+  EXPECT_EQ(svd.get_u().get_cols(), rank);
+  EXPECT_EQ(svd.get_v().get_rows(), matrix.get_cols());
+  EXPECT_EQ(svd.get_v().get_cols(), rank);
+  EXPECT_TRUE(std::is_sorted(values.rbegin(), values.rend()));
+  EXPECT_GE(values.back(), 0.0);
+  EXPECT_TRUE(svd.Reconstruct().ApproxEqual(matrix, 1e-10));
+  CheckOrthonormalColumns(svd.get_u());
+  CheckOrthonormalColumns(svd.get_v());
+}
+
+TEST(S21SVDTest, Full) {
+  CheckSvd(MakeSvdMatrix(1, 1));
+  CheckSvd(MakeSvdMatrix(5, 5));
+  CheckSvd(MakeSvdMatrix(40, 12));
+  CheckSvd(MakeSvdMatrix(9, 30));
+  CheckSvd(MakeLowRankMatrix(25, 20, 3));
+  S21Matrix diagonal(3, 2);
+  diagonal[0][1] = -4;
+  diagonal[2][0] = 3;
+  S21SVD svd(diagonal);
+  EXPECT_NEAR(svd.get_singular_values()[0], 4, 1e-14);
+  EXPECT_NEAR(svd.get_singular_values()[1], 3, 1e-14);
+  EXPECT_ANY_THROW(S21SVD{S21Matrix()});
+  S21Matrix non_finite = MakeSvdMatrix(3, 3);
+  non_finite[1][2] = NAN;
+  EXPECT_THROW(S21SVD{non_finite}, std::logic_error);
+  non_finite[1][2] = INFINITY;
+  EXPECT_THROW(S21SVD{non_finite}, std::logic_error);
+}
+
+TEST(S21SVDTest, Randomized) {
+  S21Matrix matrix = MakeLowRankMatrix(300, 80, 6);
+  for (int threads : {1, 4}) {
+    parallel::SetThreadCount(threads);
+    S21SVD svd = S21SVD::Randomized(matrix, 6);
+    S21SVD full(matrix);
+    ASSERT_EQ(svd.get_singular_values().size(), 6U);
+    for (int i = 0; i < 6; ++i) {
+      EXPECT_NEAR(svd.get_singular_values()[i], full.get_singular_values()[i],
+                  1e-8 * full.get_singular_values()[0]);
+    }
+    EXPECT_EQ(svd.get_u().get_cols(), 6);
+    EXPECT_EQ(svd.get_v().get_cols(), 6);
+    EXPECT_TRUE(svd.Reconstruct().ApproxEqual(matrix, 1e-8));
+    CheckOrthonormalColumns(svd.get_u());
+    CheckOrthonormalColumns(svd.get_v());
+  }
+  parallel::SetThreadCount(0);
+  S21SVD deficient = S21SVD::Randomized(MakeLowRankMatrix(40, 30, 2), 2, 20);
+  EXPECT_TRUE(deficient.Reconstruct().ApproxEqual(MakeLowRankMatrix(40, 30, 2),
+                                                  1e-8));
+  EXPECT_ANY_THROW(S21SVD::Randomized(matrix, 0));
+  EXPECT_ANY_THROW(S21SVD::Randomized(matrix, 81));
+  matrix[7][3] = NAN;
+  EXPECT_THROW(S21SVD::Randomized(matrix, 6), std::logic_error);
+}
+
+}  // namespace s21
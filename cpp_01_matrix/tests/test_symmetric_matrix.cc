@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+#include "../s21_parallel.h"
+#include "../s21_symmetric_matrix.h"
+
+namespace s21 {
+
+S21Matrix MakeSymmetricSource(const int rows, const int cols) {
+  S21Matrix result(rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      result[i][j] = ((i * 7 + j * 3) % 13 - 6) * 0.25 + (i == j);
+    }
+  }
+  return result;
+}
+
+TEST(S21SymmetricMatrixTest, Storage) {
+  S21Matrix source(3);
+  std::iota(source.begin(), source.end(), 1.0);
+  S21SymmetricMatrix matrix(source);
+  EXPECT_EQ(matrix.get_size(), 3);
+  EXPECT_EQ(matrix(3, 2), 8);
+  EXPECT_EQ(matrix(2, 3), 8);
+  matrix(1, 3) = -1;
+  EXPECT_EQ(matrix(3, 1), -1);
+  S21Matrix dense = matrix.ToMatrix();
+  EXPECT_TRUE(dense == dense.Transpose());
+  EXPECT_EQ(dense[0][2], -1);
+  EXPECT_ANY_THROW(matrix(0, 1));
+  EXPECT_ANY_THROW(matrix(4, 1));
+  EXPECT_ANY_THROW(S21SymmetricMatrix(S21Matrix(2, 3)));
+  EXPECT_ANY_THROW(S21SymmetricMatrix(-1));
+}
+
+TEST(S21SymmetricMatrixTest, Gram) {
+  S21Matrix source = MakeSymmetricSource(37, 21);
+  for (int threads : {1, 3}) {
+    parallel::SetThreadCount(threads);
+    EXPECT_TRUE(S21SymmetricMatrix::Gram(source).ToMatrix().ApproxEqual(
+        source.Transpose() * source, 1e-12));
+    EXPECT_TRUE(S21SymmetricMatrix::Gram(source, true).ToMatrix().ApproxEqual(
+        source * source.Transpose(), 1e-12));
+  }
+  parallel::SetThreadCount(0);
+}
+
+TEST(S21SymmetricMatrixTest, MultiplyAndSolve) {
+  S21Matrix source = MakeSymmetricSource(150, 140);
+  S21SymmetricMatrix gram = S21SymmetricMatrix::Gram(source);
+  for (int i = 1; i <= gram.get_size(); ++i) {
+    gram(i, i) += 1.0;
+  }
+  S21Matrix rhs = MakeSymmetricSource(140, 5);
+  EXPECT_TRUE((gram * rhs).ApproxEqual(gram.ToMatrix() * rhs, 1e-10));
+  S21TriangularMatrix factor = gram.Cholesky();
+  EXPECT_TRUE((factor.ToMatrix() * factor.ToMatrix().Transpose())
+                  .ApproxEqual(gram.ToMatrix(), 1e-9));
+  S21Matrix solution = gram.Solve(rhs);
+  EXPECT_TRUE((gram * solution).ApproxEqual(rhs, 1e-9));
+  EXPECT_ANY_THROW(gram * S21Matrix(3, 3));
+  EXPECT_ANY_THROW(gram.Solve(S21Matrix(3, 1)));
+}
+
+TEST(S21SymmetricMatrixTest, NotPositiveDefinite) {
+  S21SymmetricMatrix matrix(2);
+  matrix(1, 1) = 1;
+  matrix(2, 1) = 2;
+  matrix(2, 2) = 1;
+  EXPECT_ANY_THROW(matrix.Cholesky());
+  EXPECT_ANY_THROW(S21SymmetricMatrix().Cholesky());
+}
+
+}  // namespace s21
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+#include "../s21_parallel.h"
+#include "../s21_triangular_matrix.h"
+
+namespace s21 {
+
+S21Matrix MakeTriangularSource(const int size) {
+  S21Matrix result(size);
+  for (int i = 0; i < size; ++i) {
+    for (int j = 0; j < size; ++j) {
+      result[i][j] = i == j ? 2.0 + i % 3 : ((i * 3 + j * 7) % 5 - 2) * 0.1;
+    }
+  }
+  return result;
+}
+
+S21Matrix MakeTriangularRhs(const int rows, const int cols) {
+  S21Matrix result(rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      result[i][j] = (i * 5 + j * 3) % 11 - 5.0;
+    }
+  }
+  return result;
+}
+
+TEST(S21TriangularMatrixTest, Storage) {
+  S21Matrix source(3);
+  std::iota(source.begin(), source.end(), 1.0);
+  S21TriangularMatrix lower(source);
+  const S21TriangularMatrix upper(source, S21TriangularMatrix::kUpper);
+  const S21TriangularMatrix &view = lower;
+  EXPECT_EQ(lower.get_size(), 3);
+  EXPECT_EQ(lower(3, 2), 8);
+  EXPECT_EQ(view(2, 3), 0);
+  EXPECT_EQ(upper(2, 3), 6);
+  EXPECT_EQ(upper(3, 2), 0);
+  EXPECT_TRUE(lower.Transpose().ToMatrix() == lower.ToMatrix().Transpose());
+  EXPECT_EQ(upper.Transpose().get_triangle(), S21TriangularMatrix::kLower);
+  lower(3, 1) = 10;
+  EXPECT_EQ(lower.ToMatrix()[2][0], 10);
+  EXPECT_ANY_THROW(lower(1, 2) = 1);
+  EXPECT_ANY_THROW(lower(4, 1));
+  S21TriangularMatrix unit(source, S21TriangularMatrix::kLower, true);
+  EXPECT_EQ(static_cast<const S21TriangularMatrix &>(unit)(2, 2), 1);
+  EXPECT_ANY_THROW(unit(2, 2) = 3);
+  EXPECT_ANY_THROW(S21TriangularMatrix(S21Matrix(2, 3)));
+  EXPECT_ANY_THROW(S21TriangularMatrix(-1));
+}
+
+TEST(S21TriangularMatrixTest, Solve) {
+  const int size = 150;
+  S21Matrix source = MakeTriangularSource(size);
+  S21Matrix rhs = MakeTriangularRhs(size, 7);
+  for (int threads : {1, 4}) {
+    parallel::SetThreadCount(threads);
+    for (auto triangle :
+         {S21TriangularMatrix::kLower, S21TriangularMatrix::kUpper}) {
+      for (bool unit : {false, true}) {
+        S21TriangularMatrix matrix(source, triangle, unit);
+        S21Matrix solution = matrix.Solve(rhs);
+        EXPECT_TRUE((matrix.ToMatrix() * solution).ApproxEqual(rhs, 1e-9));
+        S21Matrix vector = MakeTriangularRhs(size, 1);
+        matrix.Solve(vector.data());
+        EXPECT_TRUE(vector.ApproxEqual(matrix.Solve(MakeTriangularRhs(size, 1)),
+                                       1e-12));
+      }
+    }
+  }
+  parallel::SetThreadCount(0);
+  S21TriangularMatrix singular(3);
+  EXPECT_ANY_THROW(singular.Solve(S21Matrix(3, 1)));
+  EXPECT_ANY_THROW(S21TriangularMatrix(source).Solve(S21Matrix(3, 1)));
+}
+
+TEST(S21TriangularMatrixTest, Multiply) {
+  const int size = 130;
+  S21Matrix source = MakeTriangularSource(size);
+  S21Matrix rhs = MakeTriangularRhs(size, 9);
+  for (auto triangle :
+       {S21TriangularMatrix::kLower, S21TriangularMatrix::kUpper}) {
+    for (bool unit : {false, true}) {
+      S21TriangularMatrix matrix(source, triangle, unit);
+      EXPECT_TRUE(
+          (matrix * rhs).ApproxEqual(matrix.ToMatrix() * rhs, 1e-12));
+    }
+  }
+  EXPECT_ANY_THROW(S21TriangularMatrix(source) * S21Matrix(3, 3));
+}
+
+}  // namespace s21